@@ -0,0 +1,26 @@
+#pragma once
+
+#include <chrono>
+#include <cstdlib>
+#include <string_view>
+#include <utility>
+
+// Runs fn once and returns the wall-clock time it took in milliseconds.
+template<typename Fn>
+double timeMs(Fn&& fn) {
+    auto start = std::chrono::steady_clock::now();
+    std::forward<Fn>(fn)();
+    auto stop = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::milli>(stop - start).count();
+}
+
+// Keeps the optimizer from discarding a value that is otherwise unused.
+template<typename T>
+void doNotOptimize(const T& value) {
+    asm volatile("" : : "r,m"(value) : "memory");
+}
+
+// Reads an optional numeric command line argument, falling back to def.
+inline std::size_t argOr(int argc, char** argv, int idx, std::size_t def) {
+    return idx < argc ? static_cast<std::size_t>(std::strtod(argv[idx], nullptr)) : def;
+}
@@ -0,0 +1,113 @@
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <optional>
+#include <print>
+#include <thread>
+#include <vector>
+#include "../src/hash/concurrent_hashmap.hpp"
+#include "../src/hash/hashmap.hpp"
+#include "bench_util.hpp"
+
+// Throughput of a HashMap behind one global mutex against ConcurrentHashMap, for 1 to 64 threads
+// (capped by the first argument). Both maps are preloaded with the key space; every thread then runs
+// a fixed number of operations on random keys, either read-heavy (95% lookups, 5% writes) or
+// write-heavy (50% lookups, 50% writes). Writes alternate between overwriting and erasing, so the
+// size stays close to the preloaded one. Reports millions of operations per second over all threads.
+
+namespace {
+    using Key = std::uint64_t;
+
+    struct GlobalLock {
+        mutable std::mutex mutex;
+        HashMap<Key, std::uint64_t> map;
+
+        std::optional<std::uint64_t> get(Key k) const {
+            std::lock_guard lock{mutex};
+            if (auto value = map.get(k)) {
+                return value->get();
+            }
+            return std::nullopt;
+        }
+        void insert(Key k, std::uint64_t v) {
+            std::lock_guard lock{mutex};
+            map.insert(k, v);
+        }
+        bool erase(Key k) {
+            std::lock_guard lock{mutex};
+            return map.erase(k);
+        }
+    };
+
+    // splitmix64: cheap enough that the generator does not dominate a lookup.
+    std::uint64_t nextRandom(std::uint64_t& state) {
+        std::uint64_t z = (state += 0x9E3779B97F4A7C15ull);
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+        return z ^ (z >> 31);
+    }
+
+    template<typename Map>
+    double run(Map& map, std::size_t threads, std::size_t keys, std::size_t opsPerThread, unsigned writePercent) {
+        std::vector<std::size_t> found(threads);
+        double ms = timeMs([&] {
+            std::vector<std::thread> workers;
+            for (std::size_t t = 0; t < threads; ++t) {
+                workers.emplace_back([&, t] {
+                    std::uint64_t state = t + 1;
+                    std::size_t hits = 0;
+                    for (std::size_t i = 0; i < opsPerThread; ++i) {
+                        std::uint64_t r = nextRandom(state);
+                        Key k = (r >> 8) % keys;
+                        if ((r & 0xFF) % 100 >= writePercent) {
+                            hits += map.get(k).has_value();
+                        } else if (i & 1) {
+                            hits += map.erase(k);
+                        } else {
+                            map.insert(k, i);
+                        }
+                    }
+                    found[t] = hits;
+                });
+            }
+            for (auto& worker: workers) {
+                worker.join();
+            }
+        });
+        doNotOptimize(found);
+        return static_cast<double>(threads * opsPerThread) / (ms * 1e3);
+    }
+
+    template<typename Map>
+    void preload(Map& map, std::size_t keys) {
+        for (Key k = 0; k < keys; ++k) {
+            map.insert(k, k);
+        }
+    }
+} // namespace
+
+int main(int argc, char** argv) {
+    std::size_t maxThreads = argOr(argc, argv, 1, 64);
+    std::size_t keys = argOr(argc, argv, 2, 1'000'000);
+    std::size_t opsPerThread = argOr(argc, argv, 3, 200'000);
+
+    std::println("Mops/s, {} keys, {} ops per thread, {} hardware threads", keys, opsPerThread,
+                 std::thread::hardware_concurrency());
+    std::println("{:>8} {:>14} {:>14} {:>14} {:>14}", "", "read-heavy", "", "write-heavy", "");
+    std::println("{:>8} {:>14} {:>14} {:>14} {:>14}", "threads", "global mutex", "sharded", "global mutex",
+                 "sharded");
+    for (std::size_t threads = 1; threads <= maxThreads; threads *= 2) {
+        double results[4];
+        for (std::size_t mix = 0; mix < 2; ++mix) {
+            unsigned writePercent = mix == 0 ? 5 : 50;
+            GlobalLock global;
+            preload(global, keys);
+            results[2 * mix] = run(global, threads, keys, opsPerThread, writePercent);
+            ConcurrentHashMap<Key, std::uint64_t> sharded;
+            preload(sharded, keys);
+            results[2 * mix + 1] = run(sharded, threads, keys, opsPerThread, writePercent);
+        }
+        std::println("{:>8} {:>14.1f} {:>14.1f} {:>14.1f} {:>14.1f}", threads, results[0], results[1], results[2],
+                     results[3]);
+    }
+}
@@ -0,0 +1,88 @@
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <print>
+#include <random>
+#include <span>
+#include <vector>
+#include "../src/hash/hashmap.hpp"
+#include "bench_util.hpp"
+
+// Probing a HashMap in batches of 1024 keys, as a hash join does: a loop of get() against getMany()
+// and containsMany(), which prefetch each batch's control bytes and slots before resolving them.
+// Runs on a table that fits in the cache and on one far larger than the last-level cache, with
+// lookups that all hit and lookups that all miss. Reports ns per key.
+
+namespace {
+    using Map = HashMap<std::uint64_t, std::uint64_t>;
+
+    constexpr std::size_t JOIN_BATCH{1024};
+
+    template<typename Fn>
+    double perKey(const std::vector<std::uint64_t>& probes, Fn&& probeBatch) {
+        double ms = timeMs([&] {
+            for (std::size_t base = 0; base < probes.size(); base += JOIN_BATCH) {
+                std::size_t n = std::min(JOIN_BATCH, probes.size() - base);
+                probeBatch(std::span<const std::uint64_t>{probes.data() + base, n});
+            }
+        });
+        return ms * 1e6 / static_cast<double>(probes.size());
+    }
+
+    void run(std::size_t n, std::size_t lookups) {
+        std::mt19937_64 rng(3);
+        std::vector<std::uint64_t> keys(n);
+        Map map;
+        map.reserve(n);
+        // Even keys are stored and odd keys are probed as misses.
+        for (std::size_t i = 0; i < n; ++i) {
+            keys[i] = rng() & ~std::uint64_t{1};
+            map.insert(keys[i], i);
+        }
+        std::vector<std::uint64_t> hits(lookups);
+        std::vector<std::uint64_t> misses(lookups);
+        for (std::size_t i = 0; i < lookups; ++i) {
+            hits[i] = keys[rng() % n];
+            misses[i] = rng() | 1;
+        }
+
+        const Map& probe = map;
+        std::vector<const std::uint64_t*> values(JOIN_BATCH);
+        std::unique_ptr<bool[]> present{new bool[JOIN_BATCH]};
+        std::uint64_t sum = 0;
+        for (const auto* probes: {&hits, &misses}) {
+            double loop = perKey(*probes, [&](std::span<const std::uint64_t> batch) {
+                for (std::uint64_t k: batch) {
+                    if (auto value = probe.get(k)) {
+                        sum += value->get();
+                    }
+                }
+            });
+            double many = perKey(*probes, [&](std::span<const std::uint64_t> batch) {
+                probe.getMany(batch, values);
+                for (std::size_t i = 0; i < batch.size(); ++i) {
+                    if (values[i]) {
+                        sum += *values[i];
+                    }
+                }
+            });
+            double contains = perKey(*probes, [&](std::span<const std::uint64_t> batch) {
+                sum += probe.containsMany(batch, {present.get(), JOIN_BATCH});
+            });
+            std::println("{:>10} {:<6} {:>10.1f} {:>10.1f} {:>13.1f}", n, probes == &hits ? "hit" : "miss", loop, many,
+                         contains);
+        }
+        doNotOptimize(sum);
+    }
+} // namespace
+
+int main(int argc, char** argv) {
+    std::size_t large = argOr(argc, argv, 1, 8'000'000);
+    std::size_t lookups = argOr(argc, argv, 2, 4'000'000);
+
+    std::println("ns/key, batches of {} keys", JOIN_BATCH);
+    std::println("{:>10} {:<6} {:>10} {:>10} {:>13}", "keys", "", "get loop", "getMany", "containsMany");
+    run(16'384, lookups);
+    run(large, lookups);
+}
@@ -0,0 +1,134 @@
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <print>
+#include <random>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+#include "../src/hash/hashmap.hpp"
+#include "../src/string/my_string.hpp"
+#include "bench_util.hpp"
+
+// HashMap against std::unordered_map on random 64-bit keys and on short string keys. Reports ns per
+// operation for building the table, lookups that hit, lookups that miss, and an erase-heavy churn
+// that keeps the size constant by erasing the oldest key after every insert. A last section looks
+// up String keys by string_view, as a request router does, with and without transparent hashing.
+
+namespace {
+    // Gives both maps the same insert/find/erase surface.
+    template<typename Key>
+    struct StdMap {
+        std::unordered_map<Key, std::uint64_t> map;
+
+        void insert(const Key& k, std::uint64_t v) { map.insert_or_assign(k, v); }
+        bool contains(const Key& k) const { return map.find(k) != map.end(); }
+        bool erase(const Key& k) { return map.erase(k) == 1; }
+    };
+
+    template<typename Key>
+    struct Swiss {
+        HashMap<Key, std::uint64_t> map;
+
+        void insert(const Key& k, std::uint64_t v) { map.insert(k, v); }
+        bool contains(const Key& k) const { return map.contains(k); }
+        bool erase(const Key& k) { return map.erase(k); }
+    };
+
+    template<typename Map, typename Key>
+    void run(const char* name, const std::vector<Key>& keys, const std::vector<Key>& missing) {
+        std::size_t n = keys.size();
+        Map map;
+        double buildMs = timeMs([&] {
+            for (std::size_t i = 0; i < n; ++i) {
+                map.insert(keys[i], i);
+            }
+        });
+
+        std::size_t found = 0;
+        double hitMs = timeMs([&] {
+            for (std::size_t r = 0; r < 4; ++r) {
+                for (std::size_t i = 0; i < n; ++i) {
+                    found += map.contains(keys[(i * 7919) % n]);
+                }
+            }
+        });
+        double missMs = timeMs([&] {
+            for (std::size_t r = 0; r < 4; ++r) {
+                for (std::size_t i = 0; i < n; ++i) {
+                    found += map.contains(missing[i]);
+                }
+            }
+        });
+
+        // Replace the keys one by one with the missing ones, then swap them back.
+        double churnMs = timeMs([&] {
+            for (std::size_t i = 0; i < n; ++i) {
+                map.insert(missing[i], i);
+                found += map.erase(keys[i]);
+            }
+            for (std::size_t i = 0; i < n; ++i) {
+                map.insert(keys[i], i);
+                found += map.erase(missing[i]);
+            }
+        });
+        doNotOptimize(found);
+
+        auto perOp = [](double ms, std::size_t ops) { return ms * 1e6 / static_cast<double>(ops); };
+        std::println("{:<24} {:>10.1f} {:>10.1f} {:>10.1f} {:>10.1f}", name, perOp(buildMs, n), perOp(hitMs, 4 * n),
+                     perOp(missMs, 4 * n), perOp(churnMs, 4 * n));
+    }
+
+    // Lookups by string_view: the transparent map hashes the view directly, the plain one converts
+    // it to a String (heap-allocated past the inline capacity) for every lookup.
+    template<typename Map>
+    void routeLookups(const char* name, const std::vector<std::string>& paths, std::size_t ops) {
+        Map map;
+        for (std::size_t i = 0; i < paths.size(); ++i) {
+            map.insert(String{std::string_view{paths[i]}}, i);
+        }
+        std::size_t found = 0;
+        double ms = timeMs([&] {
+            for (std::size_t i = 0; i < ops; ++i) {
+                std::string_view path{paths[(i * 7919) % paths.size()]};
+                found += map.contains(path);
+            }
+        });
+        doNotOptimize(found);
+        std::println("{:<24} {:>10.1f}", name, ms * 1e6 / static_cast<double>(ops));
+    }
+} // namespace
+
+int main(int argc, char** argv) {
+    std::size_t n = argOr(argc, argv, 1, 1'000'000);
+
+    std::mt19937_64 rng(7);
+    std::vector<std::uint64_t> intKeys(n);
+    std::vector<std::uint64_t> intMissing(n);
+    // Even keys are stored and odd keys are looked up as misses, so the two sets never overlap.
+    for (std::size_t i = 0; i < n; ++i) {
+        intKeys[i] = rng() & ~std::uint64_t{1};
+        intMissing[i] = rng() | 1;
+    }
+    std::vector<std::string> strKeys;
+    std::vector<std::string> strMissing;
+    for (std::size_t i = 0; i < n; ++i) {
+        strKeys.push_back("user:" + std::to_string(intKeys[i] >> 20));
+        strMissing.push_back("miss:" + std::to_string(intMissing[i] >> 20));
+    }
+
+    std::println("{:<24} {:>10} {:>10} {:>10} {:>10}", "ns/op", "build", "hit", "miss", "churn");
+    run<StdMap<std::uint64_t>>("unordered_map<u64>", intKeys, intMissing);
+    run<Swiss<std::uint64_t>>("HashMap<u64>", intKeys, intMissing);
+    run<StdMap<std::string>>("unordered_map<string>", strKeys, strMissing);
+    run<Swiss<std::string>>("HashMap<string>", strKeys, strMissing);
+
+    std::vector<std::string> paths;
+    for (std::size_t i = 0; i < 4096; ++i) {
+        paths.push_back("/api/v2/accounts/" + std::to_string(i) + "/transactions");
+    }
+    std::println("{:<24} {:>10}", "route lookup", "ns/op");
+    routeLookups<HashMap<String, std::uint64_t>>("HashMap<String>", paths, 4 * n);
+    routeLookups<HashMap<String, std::uint64_t, StringHash, std::equal_to<>>>("HashMap<String> transp.", paths, 4 * n);
+}
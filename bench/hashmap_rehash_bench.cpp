@@ -0,0 +1,81 @@
+#include <algorithm>
+#include <bit>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <print>
+#include <random>
+#include <vector>
+#include "../src/hash/hashmap.hpp"
+#include "bench_util.hpp"
+
+// Insert latency while a HashMap grows from empty, with the whole table rehashed by one insert
+// (RehashAtOnce) against Redis-style incremental migration (RehashIncremental). Every insert is
+// timed on its own; reports the percentiles, the worst insert and a log2 histogram of latencies.
+
+namespace {
+    using Clock = std::chrono::steady_clock;
+
+    template<typename Map>
+    std::vector<std::uint32_t> timeInserts(const std::vector<std::uint64_t>& keys) {
+        std::vector<std::uint32_t> latencies(keys.size());
+        Map map;
+        for (std::size_t i = 0; i < keys.size(); ++i) {
+            auto start = Clock::now();
+            map.insert(keys[i], i);
+            auto stop = Clock::now();
+            latencies[i] = static_cast<std::uint32_t>(
+                std::min<std::int64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(stop - start).count(),
+                                       UINT32_MAX));
+        }
+        doNotOptimize(map.size());
+        return latencies;
+    }
+
+    std::uint32_t percentile(std::vector<std::uint32_t>& sorted, double p) {
+        auto idx = static_cast<std::size_t>(p * static_cast<double>(sorted.size() - 1));
+        return sorted[idx];
+    }
+
+    void report(const char* name, std::vector<std::uint32_t> latencies, std::vector<std::vector<std::size_t>>& hist) {
+        std::vector<std::size_t> buckets(32);
+        for (std::uint32_t ns: latencies) {
+            ++buckets[static_cast<std::size_t>(std::bit_width(ns))];
+        }
+        hist.push_back(buckets);
+        std::sort(latencies.begin(), latencies.end());
+        std::println("{:<20} {:>9} {:>9} {:>9} {:>9} {:>12}", name, percentile(latencies, 0.5),
+                     percentile(latencies, 0.99), percentile(latencies, 0.999), percentile(latencies, 0.9999),
+                     latencies.back());
+    }
+} // namespace
+
+int main(int argc, char** argv) {
+    std::size_t n = argOr(argc, argv, 1, 8'000'000);
+
+    std::mt19937_64 rng(11);
+    std::vector<std::uint64_t> keys(n);
+    for (auto& key: keys) {
+        key = rng();
+    }
+
+    using AtOnce = HashMap<std::uint64_t, std::uint64_t>;
+    using Incremental =
+        HashMap<std::uint64_t, std::uint64_t, std::hash<std::uint64_t>, std::equal_to<std::uint64_t>, RehashIncremental>;
+
+    std::println("insert latency, ns, {} inserts into an empty map", n);
+    std::println("{:<20} {:>9} {:>9} {:>9} {:>9} {:>12}", "", "p50", "p99", "p99.9", "p99.99", "max");
+    std::vector<std::vector<std::size_t>> hist;
+    report("RehashAtOnce", timeInserts<AtOnce>(keys), hist);
+    report("RehashIncremental", timeInserts<Incremental>(keys), hist);
+
+    std::println("\n{:<20} {:>14} {:>18}", "latency (ns)", "RehashAtOnce", "RehashIncremental");
+    for (std::size_t b = 0; b < 32; ++b) {
+        if (hist[0][b] == 0 && hist[1][b] == 0) {
+            continue;
+        }
+        std::size_t lo = b == 0 ? 0 : std::size_t{1} << (b - 1);
+        std::println("[{:>9}, {:>9}) {:>14} {:>18}", lo, std::size_t{1} << b, hist[0][b], hist[1][b]);
+    }
+}
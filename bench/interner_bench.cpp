@@ -0,0 +1,79 @@
+#include <algorithm>
+#include <cstddef>
+#include <print>
+#include <string>
+#include <thread>
+#include <vector>
+#include "../src/string/my_string.hpp"
+#include "../src/string/string_interner.hpp"
+#include "bench_util.hpp"
+
+// Label-heavy workload: a few thousand distinct labels, compared and re-interned many times.
+// Reports equality cost for String against Atom, and intern() throughput as threads are added.
+
+namespace {
+    std::vector<std::string> makeLabels(std::size_t count) {
+        std::vector<std::string> labels;
+        for (std::size_t i = 0; i < count; ++i) {
+            labels.push_back("http_request_duration_seconds_bucket_" + std::to_string(i));
+        }
+        return labels;
+    }
+} // namespace
+
+int main(int argc, char** argv) {
+    std::size_t ops = argOr(argc, argv, 1, 20'000'000);
+    auto labels = makeLabels(4096);
+
+    StringInterner interner;
+    std::vector<String> strings;
+    std::vector<Atom> atoms;
+    for (const auto& label: labels) {
+        strings.emplace_back(std::string_view{label});
+        atoms.push_back(interner.intern(std::string_view{label}));
+    }
+    // Equal-content copies, so String comparisons cannot short-circuit on the pointer.
+    std::vector<String> copies{strings};
+
+    std::size_t equal = 0;
+    double stringMs = timeMs([&] {
+        for (std::size_t i = 0; i < ops; ++i) {
+            std::size_t a = i & 4095;
+            std::size_t b = (i * 7) & 4095;
+            equal += strings[a] == copies[b];
+        }
+    });
+    double atomMs = timeMs([&] {
+        for (std::size_t i = 0; i < ops; ++i) {
+            std::size_t a = i & 4095;
+            std::size_t b = (i * 7) & 4095;
+            equal += atoms[a] == atoms[b];
+        }
+    });
+    doNotOptimize(equal);
+    std::println("{:<20} {:>10}", "equality", "ns/op");
+    std::println("{:<20} {:>10.2f}", "String ==", stringMs * 1e6 / ops);
+    std::println("{:<20} {:>10.2f}", "Atom ==", atomMs * 1e6 / ops);
+
+    std::println("{:<20} {:>10} {:>14}", "intern (hits)", "threads", "Mops/s total");
+    std::size_t maxThreads = std::max(1u, std::thread::hardware_concurrency());
+    for (std::size_t threads = 1; threads <= maxThreads; threads *= 2) {
+        std::size_t perThread = ops / 4 / threads;
+        double ms = timeMs([&] {
+            std::vector<std::thread> workers;
+            for (std::size_t t = 0; t < threads; ++t) {
+                workers.emplace_back([&, t] {
+                    std::size_t sum = 0;
+                    for (std::size_t i = 0; i < perThread; ++i) {
+                        sum += interner.intern(std::string_view{labels[(i + t * 97) & 4095]}).id();
+                    }
+                    doNotOptimize(sum);
+                });
+            }
+            for (auto& worker: workers) {
+                worker.join();
+            }
+        });
+        std::println("{:<20} {:>10} {:>14.1f}", "", threads, static_cast<double>(perThread * threads) / ms / 1e3);
+    }
+}
@@ -0,0 +1,103 @@
+#include <algorithm>
+#include <cstddef>
+#include <filesystem>
+#include <fstream>
+#include <print>
+#include <random>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+#include "../src/string/my_string.hpp"
+#include "../src/string/record_reader.hpp"
+#include "bench_util.hpp"
+
+// Loading a large CSV file: the old way (getline, then copy every field into a String) against
+// RecordReader handing out string_views from the mapping, from pread blocks, and from several
+// threads. Each run counts fields so the work per byte is the same. The file is in the page cache.
+
+namespace {
+    std::filesystem::path writeCsv(std::size_t bytes) {
+        auto path = std::filesystem::temp_directory_path() / ("record_reader_bench_" + std::to_string(::getpid()));
+        std::ofstream out(path, std::ios::binary);
+        std::mt19937_64 rng{3};
+        std::size_t written = 0;
+        while (written < bytes) {
+            auto id = rng();
+            std::string line = std::to_string(id) + ",user_" + std::to_string(id % 100000) +
+                               ",2024-05-01T12:00:00Z,/v1/items/" + std::to_string(id % 1000) + "," +
+                               std::to_string(id % 500) + "\n";
+            out << line;
+            written += line.size();
+        }
+        return path;
+    }
+
+    std::size_t countFields(std::string_view record) {
+        return simdCount(record.data(), record.size(), ',') + 1;
+    }
+
+    void report(const char* name, double ms, std::size_t bytes, std::size_t fields) {
+        std::println("{:<28} {:>10.1f} {:>10.2f} {:>12}", name, ms, static_cast<double>(bytes) / ms / 1e6, fields);
+    }
+} // namespace
+
+int main(int argc, char** argv) {
+    std::size_t bytes = argOr(argc, argv, 1, 256 << 20);
+    auto path = writeCsv(bytes);
+    std::size_t fileSize = std::filesystem::file_size(path);
+
+    std::println("{:<28} {:>10} {:>10} {:>12}", "reader", "ms", "GB/s", "fields");
+
+    std::size_t fields = 0;
+    double ms = timeMs([&] {
+        std::ifstream in(path, std::ios::binary);
+        std::vector<String> row;
+        std::string line;
+        while (std::getline(in, line)) {
+            row.clear();
+            for (std::string_view field: StrSplitView<char>{line, ','}) {
+                row.emplace_back(field);
+            }
+            fields += row.size();
+        }
+    });
+    report("getline + String fields", ms, fileSize, fields);
+
+    fields = 0;
+    ms = timeMs([&] {
+        RecordReader reader(path, {'\n', RecordReader::Backend::Map, 1 << 20});
+        reader.for_each([&](std::string_view record) { fields += countFields(record); });
+    });
+    report("RecordReader mmap", ms, fileSize, fields);
+
+    fields = 0;
+    ms = timeMs([&] {
+        RecordReader reader(path, {'\n', RecordReader::Backend::Read, 1 << 20});
+        reader.for_each([&](std::string_view record) { fields += countFields(record); });
+    });
+    report("RecordReader pread 1 MiB", ms, fileSize, fields);
+
+    std::size_t threads = std::max(1u, std::thread::hardware_concurrency());
+    fields = 0;
+    ms = timeMs([&] {
+        RecordReader reader(path);
+        // One cache line per worker, so the counters do not false-share.
+        std::vector<std::size_t> perWorker(threads * 8);
+        reader.for_each_parallel(threads, [&](std::string_view record, std::size_t worker) {
+            perWorker[worker * 8] += countFields(record);
+        });
+        for (std::size_t count: perWorker) {
+            fields += count;
+        }
+    });
+    std::println("{:<28} {:>10.1f} {:>10.2f} {:>12}  ({} threads)", "RecordReader parallel", ms,
+                 static_cast<double>(fileSize) / ms / 1e6, fields, threads);
+
+    std::size_t records = 0;
+    ms = timeMs([&] { records = RecordReader(path).to_strings().size(); });
+    report("RecordReader to_strings", ms, fileSize, records);
+
+    std::filesystem::remove(path);
+}
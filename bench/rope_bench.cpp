@@ -0,0 +1,94 @@
+#include <cstddef>
+#include <print>
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "../src/string/my_rope.hpp"
+#include "../src/string/my_string.hpp"
+#include "bench_util.hpp"
+
+// Assembling a ~100 MB document from 1M fragments of 50-150 bytes, then taking slices of it.
+// String::operator+ is left out: it copies the whole prefix on every step and would take hours.
+
+namespace {
+    std::vector<std::string> makeFragments(std::size_t count) {
+        std::mt19937_64 rng{7};
+        std::uniform_int_distribution<std::size_t> len(50, 150);
+        std::vector<std::string> fragments(count);
+        for (std::size_t i = 0; i < count; ++i) {
+            fragments[i].assign(len(rng), static_cast<char>('a' + i % 26));
+        }
+        return fragments;
+    }
+} // namespace
+
+int main(int argc, char** argv) {
+    std::size_t count = argOr(argc, argv, 1, 1'000'000);
+    auto fragments = makeFragments(count);
+
+    Rope rope;
+    double ropeMs = timeMs([&] {
+        for (const auto& fragment: fragments) {
+            rope += Rope{std::string_view{fragment}};
+        }
+    });
+
+    Rope built;
+    double builderMs = timeMs([&] {
+        Rope::Builder builder;
+        for (const auto& fragment: fragments) {
+            builder.append(std::string_view{fragment});
+        }
+        built = std::move(builder).build();
+    });
+
+    String str;
+    double appendMs = timeMs([&] {
+        for (const auto& fragment: fragments) {
+            str.append(std::string_view{fragment});
+        }
+    });
+    doNotOptimize(str.data());
+
+    std::string stdStr;
+    double stdMs = timeMs([&] {
+        for (const auto& fragment: fragments) {
+            stdStr.append(fragment);
+        }
+    });
+    doNotOptimize(stdStr.data());
+
+    std::println("document: {:.1f} MB from {} fragments, rope height {}", static_cast<double>(rope.size()) / 1e6,
+                 count, rope.height());
+    std::println("{:<24} {:>10}", "build", "ms");
+    std::println("{:<24} {:>10.1f}", "Rope +=", ropeMs);
+    std::println("{:<24} {:>10.1f}", "Rope::Builder", builderMs);
+    std::println("{:<24} {:>10.1f}", "String::append", appendMs);
+    std::println("{:<24} {:>10.1f}", "std::string::append", stdMs);
+
+    constexpr std::size_t slices = 100'000;
+    std::mt19937_64 rng{11};
+    std::uniform_int_distribution<std::size_t> pos(0, rope.size() / 2);
+    std::size_t total = 0;
+    double substrMs = timeMs([&] {
+        for (std::size_t i = 0; i < slices; ++i) {
+            total += rope.substr(pos(rng), rope.size() / 4).size();
+        }
+    });
+    double stdSubstrMs = timeMs([&] {
+        for (std::size_t i = 0; i < 100; ++i) {
+            total += stdStr.substr(pos(rng), stdStr.size() / 4).size();
+        }
+    });
+    doNotOptimize(total);
+
+    String flat;
+    double flattenMs = timeMs([&] { flat = rope.flatten(); });
+    doNotOptimize(flat.data());
+
+    std::println("{:<24} {:>10}", "slice (quarter doc)", "us/op");
+    std::println("{:<24} {:>10.2f}", "Rope::substr", substrMs * 1e3 / slices);
+    std::println("{:<24} {:>10.2f}", "std::string::substr", stdSubstrMs * 1e3 / 100);
+    std::println("{:<24} {:>10.1f} ms", "Rope::flatten", flattenMs);
+}
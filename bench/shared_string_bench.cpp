@@ -0,0 +1,74 @@
+#include <cstddef>
+#include <malloc.h>
+#include <print>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "../src/string/my_string.hpp"
+#include "../src/string/shared_string.hpp"
+#include "bench_util.hpp"
+
+// Fan-out of large payloads: each message is handed to several consumers, and each consumer also
+// keeps a small header slice of it. String copies the payload and the slice every time;
+// SharedString bumps a reference count. Reports time per message and heap bytes in use while a
+// batch of messages is fanned out (glibc mallinfo2).
+
+namespace {
+    constexpr std::size_t consumers = 8;
+    constexpr std::size_t batch = 64;
+
+    std::size_t heapInUse() {
+        struct mallinfo2 info = mallinfo2();
+        return info.uordblks + info.hblkhd;
+    }
+
+    template<typename Str, typename Slice>
+    void fanOut(const std::vector<Str>& messages, std::vector<Str>& copies, std::vector<Str>& headers, Slice slice) {
+        for (const Str& message: messages) {
+            for (std::size_t c = 0; c < consumers; ++c) {
+                copies.push_back(message);
+                headers.push_back(slice(message));
+            }
+        }
+    }
+
+    template<typename Str, typename Slice>
+    void run(const char* name, std::size_t payloadLen, std::size_t rounds, Slice slice) {
+        std::string text(payloadLen, 'x');
+        std::vector<Str> messages;
+        for (std::size_t i = 0; i < batch; ++i) {
+            text[0] = static_cast<char>('a' + i % 26);
+            messages.emplace_back(std::string_view{text});
+        }
+
+        std::size_t peak = 0;
+        double ms = timeMs([&] {
+            for (std::size_t r = 0; r < rounds; ++r) {
+                std::size_t before = heapInUse();
+                std::vector<Str> copies;
+                std::vector<Str> headers;
+                copies.reserve(batch * consumers);
+                headers.reserve(batch * consumers);
+                fanOut(messages, copies, headers, slice);
+                doNotOptimize(copies.back().data());
+                if (r == 0) {
+                    peak = heapInUse() - before;
+                }
+            }
+        });
+        std::println("{:<14} {:>10} {:>14.1f} {:>16.1f}", name, payloadLen,
+                     ms * 1e6 / static_cast<double>(rounds * batch), static_cast<double>(peak) / 1024);
+    }
+} // namespace
+
+int main(int argc, char** argv) {
+    std::size_t rounds = argOr(argc, argv, 1, 200);
+
+    std::println("{:<14} {:>10} {:>14} {:>16}", "type", "payload", "ns/message", "fan-out KiB");
+    for (std::size_t payloadLen: {std::size_t{256}, std::size_t{16} << 10, std::size_t{1} << 20}) {
+        std::size_t r = payloadLen >= (1 << 20) ? rounds / 20 + 1 : rounds;
+        run<String>("String", payloadLen, r,
+                    [](const String& s) { return String{std::string_view{s.data(), 64}}; });
+        run<SharedString>("SharedString", payloadLen, r, [](const SharedString& s) { return s.substr(0, 64); });
+    }
+}
@@ -0,0 +1,58 @@
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <print>
+#include "../src/vector/my_small_vec.hpp"
+#include "../src/vector/my_vec.hpp"
+#include "bench_util.hpp"
+
+// Heap allocations and time per "request" that builds a short vector of k elements, comparing
+// Vector against SmallVector with 8 inline slots.
+
+namespace {
+    std::size_t allocations = 0;
+
+    template<typename T>
+    struct CountingAllocator : std::allocator<T> {
+        template<typename U>
+        struct rebind {
+            using other = CountingAllocator<U>;
+        };
+
+        CountingAllocator() = default;
+
+        template<typename U>
+        CountingAllocator(const CountingAllocator<U>&) {}
+
+        T* allocate(std::size_t n) {
+            ++allocations;
+            return std::allocator<T>::allocate(n);
+        }
+    };
+
+    template<typename Vec>
+    void measure(const char* name, std::size_t elems, std::size_t rounds) {
+        allocations = 0;
+        double ms = timeMs([&] {
+            for (std::size_t r = 0; r < rounds; ++r) {
+                Vec vec;
+                for (std::size_t i = 0; i < elems; ++i) {
+                    vec.pushBack(static_cast<std::uint64_t>(i + r));
+                }
+                doNotOptimize(vec.data());
+            }
+        });
+        std::println("{:<14} {:>6} {:>14.2f} {:>12.1f}", name, elems, static_cast<double>(allocations) / rounds,
+                     ms * 1e6 / rounds);
+    }
+} // namespace
+
+int main(int argc, char** argv) {
+    std::size_t rounds = argOr(argc, argv, 1, 1'000'000);
+
+    std::println("{:<14} {:>6} {:>14} {:>12}", "container", "elems", "allocs/op", "ns/op");
+    for (std::size_t elems: {1, 4, 8, 16}) {
+        measure<Vector<std::uint64_t, CountingAllocator<std::uint64_t>>>("Vector", elems, rounds);
+        measure<SmallVector<std::uint64_t, 8, CountingAllocator<std::uint64_t>>>("SmallVector<8>", elems, rounds);
+    }
+}
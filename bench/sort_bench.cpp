@@ -0,0 +1,77 @@
+#include <algorithm>
+#include <cstdint>
+#include <print>
+#include <random>
+#include <utility>
+#include <vector>
+#include "../src/vector/my_vec.hpp"
+#include "../src/vector/vec_sort.hpp"
+#include "bench_util.hpp"
+
+#if defined(DS_BENCH_PAR_STL)
+#include <execution>
+#endif
+
+// Sorts n random keys (argv[1], default 1e7) with std::sort, std::sort(std::execution::par) when
+// built against TBB (DS_BENCH_PAR_STL, reported as -1 otherwise), radixSort, parallelRadixSort,
+// parallelSort and adaptiveSort.
+
+namespace {
+    using KeyPayload = std::pair<std::uint64_t, std::uint64_t>;
+
+    template<typename T>
+    Vector<T> makeInput(std::size_t n) {
+        std::mt19937_64 rng{42};
+        Vector<T> vec;
+        vec.reserve(n);
+        for (std::size_t i = 0; i < n; ++i) {
+            if constexpr (std::is_same_v<T, KeyPayload>) {
+                vec.pushBack({rng(), i});
+            } else if constexpr (std::is_floating_point_v<T>) {
+                vec.pushBack(std::uniform_real_distribution<T>(-1e9, 1e9)(rng));
+            } else {
+                vec.pushBack(static_cast<T>(rng()));
+            }
+        }
+        return vec;
+    }
+
+    template<typename T, typename Proj = std::identity>
+    void measure(const char* name, std::size_t n, Proj proj = {}) {
+        const Vector<T> input = makeInput<T>(n);
+        auto less = [&](const T& a, const T& b) { return std::invoke(proj, a) < std::invoke(proj, b); };
+        auto run = [&](auto sorter) {
+            Vector<T> vec = input;
+            double ms = timeMs([&] { sorter(vec); });
+            if (!std::is_sorted(vec.begin(), vec.end(), less)) {
+                std::println("  (unsorted result!)");
+            }
+            return ms;
+        };
+
+        double stdMs = run([&](Vector<T>& v) { std::sort(v.begin(), v.end(), less); });
+        double parMs = -1;
+#if defined(DS_BENCH_PAR_STL)
+        parMs = run([&](Vector<T>& v) { std::sort(std::execution::par, v.begin(), v.end(), less); });
+#endif
+        double radixMs = run([&](Vector<T>& v) { radixSort(v, proj); });
+        double parRadixMs = run([&](Vector<T>& v) { parallelRadixSort(v, proj); });
+        double sampleMs = run([&](Vector<T>& v) { parallelSort(v, std::ranges::less{}, proj); });
+        double autoMs = run([&](Vector<T>& v) { adaptiveSort(v, std::ranges::less{}, proj); });
+
+        std::println("{:<12} {:>10.1f} {:>10.1f} {:>10.1f} {:>12.1f} {:>10.1f} {:>10.1f}", name, stdMs, parMs, radixMs,
+                     parRadixMs, sampleMs, autoMs);
+    }
+} // namespace
+
+int main(int argc, char** argv) {
+    std::size_t n = argOr(argc, argv, 1, 10'000'000);
+
+    std::println("n = {}, threads = {}", n, SortThreads::available());
+    std::println("{:<12} {:>10} {:>10} {:>10} {:>12} {:>10} {:>10}", "keys", "std::sort", "std par", "radix",
+                 "par radix", "sample", "adaptive");
+    measure<std::uint64_t>("uint64", n);
+    measure<std::int32_t>("int32", n);
+    measure<double>("double", n);
+    measure<KeyPayload>("pair<u64>", n, &KeyPayload::first);
+}
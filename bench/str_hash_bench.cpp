@@ -0,0 +1,70 @@
+#include <cstddef>
+#include <functional>
+#include <print>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "../src/string/my_string.hpp"
+#include "../src/string/str_hash.hpp"
+#include "bench_util.hpp"
+
+// Hashing throughput by key length: wyhash (hashBytes) against std::hash<std::string_view>, and
+// String::hash() against HashedString::hash(), which returns the hash computed on construction.
+
+namespace {
+    std::vector<std::string> makeKeys(std::size_t count, std::size_t len) {
+        std::vector<std::string> keys;
+        for (std::size_t i = 0; i < count; ++i) {
+            std::string key = std::to_string(i * 2654435761u);
+            key.resize(len, static_cast<char>('a' + i % 26));
+            keys.push_back(std::move(key));
+        }
+        return keys;
+    }
+} // namespace
+
+int main(int argc, char** argv) {
+    std::size_t bytesPerRow = argOr(argc, argv, 1, 1 << 28);
+
+    std::println("{:>6} {:>16} {:>16} {:>14} {:>20}", "len", "std::hash GB/s", "hashBytes GB/s", "String ns/op",
+                 "HashedString ns/op");
+    for (std::size_t len: {4, 8, 16, 32, 64, 256, 1024, 4096}) {
+        constexpr std::size_t keyCount = 256;
+        auto keys = makeKeys(keyCount, len);
+        std::vector<String> strings;
+        std::vector<HashedString> hashed;
+        for (const auto& key: keys) {
+            strings.emplace_back(std::string_view{key});
+            hashed.emplace_back(std::string_view{key});
+        }
+        std::size_t ops = bytesPerRow / len;
+        std::size_t sum = 0;
+
+        double stdMs = timeMs([&] {
+            for (std::size_t i = 0; i < ops; ++i) {
+                sum += std::hash<std::string_view>{}(keys[i % keyCount]);
+            }
+        });
+        double wyMs = timeMs([&] {
+            for (std::size_t i = 0; i < ops; ++i) {
+                const auto& key = keys[i % keyCount];
+                sum += hashBytes(key.data(), key.size());
+            }
+        });
+        double stringMs = timeMs([&] {
+            for (std::size_t i = 0; i < ops; ++i) {
+                sum += strings[i % keyCount].hash();
+            }
+        });
+        double hashedMs = timeMs([&] {
+            for (std::size_t i = 0; i < ops; ++i) {
+                sum += hashed[i % keyCount].hash();
+            }
+        });
+        doNotOptimize(sum);
+
+        double bytes = static_cast<double>(ops * len);
+        std::println("{:>6} {:>16.2f} {:>16.2f} {:>14.2f} {:>20.2f}", len, bytes / stdMs / 1e6, bytes / wyMs / 1e6,
+                     stringMs * 1e6 / static_cast<double>(ops), hashedMs * 1e6 / static_cast<double>(ops));
+    }
+}
@@ -0,0 +1,86 @@
+#include <algorithm>
+#include <cstddef>
+#include <print>
+#include <random>
+#include <string>
+#include <string_view>
+#include "../src/string/my_string.hpp"
+#include "bench_util.hpp"
+
+// A log-parser workload over synthetic log lines: split into lines, look for a substring in each
+// and count a delimiter, with String's SIMD search against the scalar std::string_view algorithms.
+
+namespace {
+    String makeLog(std::size_t bytes) {
+        const char* levels[] = {"INFO", "DEBUG", "WARN", "ERROR"};
+        std::mt19937_64 rng{5};
+        String log;
+        log.reserve(bytes + 256);
+        while (log.size() < bytes) {
+            auto id = rng();
+            log += "2024-05-01T12:00:00.000Z ";
+            log += levels[id % 4];
+            log += " service=api request_id=";
+            log += std::to_string(id).c_str();
+            log += " path=/v1/items/";
+            log += std::to_string(id % 1000).c_str();
+            log += " latency_ms=";
+            log += std::to_string(id % 500).c_str();
+            log += '\n';
+        }
+        return log;
+    }
+
+    void report(const char* name, double ms, std::size_t bytes, std::size_t result) {
+        std::println("{:<34} {:>10.1f} {:>10.2f} {:>12}", name, ms, static_cast<double>(bytes) / ms / 1e6, result);
+    }
+} // namespace
+
+int main(int argc, char** argv) {
+    std::size_t bytes = argOr(argc, argv, 1, 256 << 20);
+    String log = makeLog(bytes);
+    std::string_view view{log.data(), log.size()};
+
+    std::println("{:<34} {:>10} {:>10} {:>12}", "operation", "ms", "GB/s", "result");
+
+    std::size_t errors = 0;
+    double ms = timeMs([&] {
+        for (std::string_view line: log.split('\n')) {
+            errors += simdFind(line.data(), line.size(), " ERROR ", 7) != line.size();
+        }
+    });
+    report("String split + find", ms, log.size(), errors);
+
+    errors = 0;
+    ms = timeMs([&] {
+        std::size_t start = 0;
+        while (start < view.size()) {
+            std::size_t end = view.find('\n', start);
+            if (end == std::string_view::npos) {
+                end = view.size();
+            }
+            errors += view.substr(start, end - start).find(" ERROR ") != std::string_view::npos;
+            start = end + 1;
+        }
+    });
+    report("string_view find + find", ms, log.size(), errors);
+
+    std::size_t hits = 0;
+    ms = timeMs([&] { hits = log.count("latency_ms=4"); });
+    report("String count(substring)", ms, log.size(), hits);
+
+    ms = timeMs([&] {
+        hits = 0;
+        for (std::size_t pos = view.find("latency_ms=4"); pos != std::string_view::npos;
+             pos = view.find("latency_ms=4", pos + 12)) {
+            ++hits;
+        }
+    });
+    report("string_view find loop", ms, log.size(), hits);
+
+    ms = timeMs([&] { hits = log.count('='); });
+    report("String count(char)", ms, log.size(), hits);
+
+    ms = timeMs([&] { hits = static_cast<std::size_t>(std::ranges::count(view, '=')); });
+    report("std::ranges::count", ms, log.size(), hits);
+}
@@ -0,0 +1,58 @@
+#include <cstddef>
+#include <print>
+#include <string>
+#include "../src/string/my_string.hpp"
+#include "bench_util.hpp"
+
+// Time to build one string of n bytes from 16-byte pieces: rebuilding with operator+ (the only
+// option before append existed), String::append, and std::string::append. The first grows
+// quadratically with n, the other two linearly.
+
+namespace {
+    constexpr const char* piece = "field=value;    ";
+    constexpr std::size_t pieceLen = 16;
+
+    template<typename Fn>
+    double perByteNs(std::size_t n, std::size_t rounds, Fn&& build) {
+        double ms = timeMs([&] {
+            for (std::size_t r = 0; r < rounds; ++r) {
+                build(n);
+            }
+        });
+        return ms * 1e6 / static_cast<double>(rounds * n);
+    }
+} // namespace
+
+int main(int argc, char** argv) {
+    std::size_t maxLen = argOr(argc, argv, 1, 1 << 20);
+
+    std::println("{:>10} {:>14} {:>14} {:>14}", "bytes", "op+ ns/B", "append ns/B", "std ns/B");
+    for (std::size_t n = 1024; n <= maxLen; n *= 4) {
+        std::size_t rounds = std::max<std::size_t>(1, (1 << 22) / n);
+        // operator+ is quadratic; cap its size so the run stays short.
+        double plus = n <= (1 << 16) ? perByteNs(n, rounds, [](std::size_t len) {
+            String str;
+            String part{piece};
+            while (str.size() < len) {
+                str = str + part;
+            }
+            doNotOptimize(str.data());
+        })
+                                     : 0.0;
+        double append = perByteNs(n, rounds, [](std::size_t len) {
+            String str;
+            while (str.size() < len) {
+                str.append(std::string_view{piece, pieceLen});
+            }
+            doNotOptimize(str.data());
+        });
+        double stdAppend = perByteNs(n, rounds, [](std::size_t len) {
+            std::string str;
+            while (str.size() < len) {
+                str.append(piece, pieceLen);
+            }
+            doNotOptimize(str.data());
+        });
+        std::println("{:>10} {:>14.3f} {:>14.3f} {:>14.3f}", n, plus, append, stdAppend);
+    }
+}
@@ -0,0 +1,88 @@
+#include <algorithm>
+#include <cstddef>
+#include <optional>
+#include <print>
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "../src/string/my_string.hpp"
+#include "../src/string/string_arena.hpp"
+#include "bench_util.hpp"
+
+// Bulk parsing: split a synthetic CSV into fields and keep every field, then throw the result
+// away. Fields are 24-96 bytes, so most of them are too long for String's inline buffer. Parse
+// and teardown are timed separately for vector<String> and for StringArena + vector<ArenaString>.
+
+namespace {
+    std::string makeCsv(std::size_t bytes) {
+        std::mt19937_64 rng{17};
+        std::uniform_int_distribution<std::size_t> len{24, 96};
+        std::string csv;
+        csv.reserve(bytes + 512);
+        while (csv.size() < bytes) {
+            for (int field = 0; field < 6; ++field) {
+                std::size_t n = len(rng);
+                for (std::size_t i = 0; i < n; ++i) {
+                    csv.push_back(static_cast<char>('a' + (rng() % 26)));
+                }
+                csv.push_back(field == 5 ? '\n' : ',');
+            }
+        }
+        return csv;
+    }
+
+    template<typename Parse>
+    void forEachField(std::string_view csv, Parse&& parse) {
+        for (std::string_view line: StrSplitView<char>{csv, '\n'}) {
+            for (std::string_view field: StrSplitView<char>{line, ','}) {
+                parse(field);
+            }
+        }
+    }
+
+    void report(const char* name, double parseMs, double freeMs, std::size_t bytes) {
+        std::println("{:<28} {:>10.1f} {:>10.1f} {:>12.2f}", name, parseMs, freeMs,
+                     static_cast<double>(bytes) / (parseMs + freeMs) / 1e6);
+    }
+} // namespace
+
+int main(int argc, char** argv) {
+    std::size_t bytes = argOr(argc, argv, 1, 256 << 20);
+    std::string csv = makeCsv(bytes);
+
+    std::println("{:<28} {:>10} {:>10} {:>12}", "storage", "parse ms", "free ms", "GB/s total");
+
+    // Both result vectors are reserved up front so that only string storage is compared; growing
+    // them interleaves large vector buffers with the arena's chunks and mostly measures malloc.
+    std::size_t fields = 0;
+    forEachField(csv, [&](std::string_view) { ++fields; });
+
+    // Alternate the two a few times and keep the best round, since whichever runs second inherits
+    // the first one's freshly freed heap.
+    double stringParse = 1e300, stringFree = 1e300, arenaParse = 1e300, arenaFree = 1e300;
+    for (int round = 0; round < 3; ++round) {
+        std::optional<std::vector<String>> strings{std::in_place};
+        strings->reserve(fields);
+        stringParse = std::min(stringParse, timeMs([&] {
+                                   forEachField(csv, [&](std::string_view field) { strings->emplace_back(field); });
+                               }));
+        doNotOptimize(strings->back().data());
+        stringFree = std::min(stringFree, timeMs([&] { strings.reset(); }));
+
+        std::optional<StringArena> arena{std::in_place};
+        std::optional<std::vector<ArenaString>> views{std::in_place};
+        views->reserve(fields);
+        arenaParse = std::min(arenaParse, timeMs([&] {
+                                  forEachField(csv,
+                                               [&](std::string_view field) { views->push_back(arena->store(field)); });
+                              }));
+        doNotOptimize(views->back().data());
+        arenaFree = std::min(arenaFree, timeMs([&] {
+                                 views.reset();
+                                 arena.reset();
+                             }));
+    }
+    report("vector<String>", stringParse, stringFree, csv.size());
+    report("StringArena", arenaParse, arenaFree, csv.size());
+}
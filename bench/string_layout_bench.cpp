@@ -0,0 +1,136 @@
+#include <algorithm>
+#include <cstddef>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <print>
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "../src/string/my_string.hpp"
+#include "bench_util.hpp"
+
+// Memory footprint, copy and compare cost of the 24-byte String against the previous 40-byte
+// layout (32-byte inline buffer plus a separate length), over strings of 4 to 40 characters, and
+// of HashedString, which adds the cached hash to a String.
+
+namespace {
+    std::size_t heapBytes = 0;
+
+    // The previous String layout, reduced to what the benchmark exercises.
+    class LegacyString {
+    public:
+        static constexpr std::size_t SSO_LEN{31};
+
+        LegacyString(std::string_view view) : m_length{view.size()} {
+            char* dst = m_sso;
+            if (m_length > SSO_LEN) {
+                m_data = new char[m_length + 1];
+                dst = m_data;
+            }
+            std::memcpy(dst, view.data(), m_length);
+            dst[m_length] = '\0';
+        }
+
+        LegacyString(const LegacyString& other) : m_length{other.m_length} {
+            if (other.is_sso()) {
+                std::memcpy(m_sso, other.m_sso, SSO_LEN + 1);
+            } else {
+                m_data = new char[m_length + 1];
+                std::memcpy(m_data, other.m_data, m_length + 1);
+            }
+        }
+
+        LegacyString& operator=(const LegacyString&) = delete;
+
+        ~LegacyString() {
+            if (!is_sso()) {
+                delete[] m_data;
+            }
+        }
+
+        auto operator<=>(const LegacyString& other) const noexcept {
+            return std::lexicographical_compare_three_way(data(), data() + m_length, other.data(),
+                                                          other.data() + other.m_length);
+        }
+
+        bool operator==(const LegacyString& other) const noexcept {
+            return m_length == other.m_length && std::memcmp(data(), other.data(), m_length) == 0;
+        }
+
+        [[nodiscard]] const char* data() const noexcept { return is_sso() ? m_sso : m_data; }
+
+    private:
+        union {
+            char m_sso[SSO_LEN + 1]{};
+            char* m_data;
+        };
+
+        std::size_t m_length{};
+
+        [[nodiscard]] bool is_sso() const noexcept { return m_length <= SSO_LEN; }
+    };
+
+    std::vector<std::string> makeInputs(std::size_t n) {
+        std::mt19937_64 rng{42};
+        std::uniform_int_distribution<std::size_t> len(4, 40);
+        std::uniform_int_distribution<int> ch('a', 'z');
+        std::vector<std::string> inputs(n);
+        for (auto& s: inputs) {
+            s.resize(len(rng));
+            for (auto& c: s) {
+                c = static_cast<char>(ch(rng));
+            }
+        }
+        return inputs;
+    }
+
+    template<typename Str>
+    void measure(const char* name, const std::vector<std::string>& inputs) {
+        std::vector<Str> strs;
+        strs.reserve(inputs.size());
+        heapBytes = 0;
+        for (const auto& s: inputs) {
+            strs.emplace_back(std::string_view{s});
+        }
+        double bytesPerString = static_cast<double>(sizeof(Str) * inputs.size() + heapBytes) / inputs.size();
+
+        double copyMs = timeMs([&] {
+            std::vector<Str> copy{strs};
+            doNotOptimize(copy.data());
+        });
+
+        std::size_t less = 0;
+        double compareMs = timeMs([&] {
+            for (std::size_t i = 1; i < strs.size(); ++i) {
+                less += strs[i - 1] < strs[i];
+                less += strs[i - 1] == strs[i];
+            }
+        });
+        doNotOptimize(less);
+
+        std::println("{:<14} {:>8} {:>14.1f} {:>12.1f} {:>12.1f}", name, sizeof(Str), bytesPerString, copyMs, compareMs);
+    }
+} // namespace
+
+void* operator new(std::size_t size) {
+    heapBytes += size;
+    if (void* p = std::malloc(size)) {
+        return p;
+    }
+    throw std::bad_alloc{};
+}
+
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+
+int main(int argc, char** argv) {
+    std::size_t n = argOr(argc, argv, 1, 5'000'000);
+    auto inputs = makeInputs(n);
+
+    std::println("{:<14} {:>8} {:>14} {:>12} {:>12}", "layout", "sizeof", "bytes/string", "copy ms", "compare ms");
+    measure<LegacyString>("40-byte legacy", inputs);
+    measure<String>("24-byte String", inputs);
+    measure<HashedString>("HashedString", inputs);
+}
@@ -0,0 +1,106 @@
+#include <cstddef>
+#include <print>
+#include <random>
+#include <string>
+#include <string_view>
+#include <utility>
+#include "../src/simd/utf8.hpp"
+#include "../src/string/my_string.hpp"
+#include "bench_util.hpp"
+
+// UTF-8 validation and code point counting over three corpora: pure ASCII, mostly ASCII with some
+// accented Latin (log lines, labels), and mostly 3 and 4 byte sequences (CJK, emoji). The baseline
+// is the byte-at-a-time decoder in ScalarUtf8. Also times ASCII case-insensitive compare, as used
+// for HTTP header names, against a tolower loop.
+
+namespace {
+    std::string makeCorpus(std::size_t bytes, unsigned multibytePercent) {
+        static const char* multibyte[] = {"\xC3\xA9", "\xC3\xBC", "\xE2\x82\xAC", "\xE4\xB8\xAD", "\xE6\x96\x87",
+                                          "\xF0\x9F\x98\x80"};
+        std::mt19937 rng{11};
+        std::string text;
+        text.reserve(bytes + 4);
+        while (text.size() < bytes) {
+            if (rng() % 100 < multibytePercent) {
+                text += multibyte[rng() % 6];
+            } else {
+                text += static_cast<char>('a' + rng() % 26);
+            }
+        }
+        return text;
+    }
+
+    bool tolowerEquals(std::string_view a, std::string_view b) {
+        if (a.size() != b.size()) {
+            return false;
+        }
+        for (std::size_t i = 0; i < a.size(); ++i) {
+            auto fold = [](unsigned char c) { return c >= 'A' && c <= 'Z' ? c | 0x20 : c; };
+            if (fold(static_cast<unsigned char>(a[i])) != fold(static_cast<unsigned char>(b[i]))) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    double gbps(std::size_t bytes, double ms) { return static_cast<double>(bytes) / ms / 1e6; }
+} // namespace
+
+int main(int argc, char** argv) {
+    std::size_t bytes = argOr(argc, argv, 1, 64 << 20);
+    constexpr int reps = 8;
+
+    std::println("{:<16} {:>14} {:>14} {:>14} {:>14}", "corpus", "scalar valid", "simd valid", "scalar count",
+                 "simd count");
+    for (auto [name, percent]: {std::pair{"ascii", 0u}, std::pair{"mixed 10%", 10u}, std::pair{"multibyte 90%", 90u}}) {
+        std::string text = makeCorpus(bytes, percent);
+        std::size_t ok = 0;
+        std::size_t cps = 0;
+        double scalarValid = timeMs([&] {
+            for (int r = 0; r < reps; ++r) {
+                ok += ScalarUtf8::validate(text.data(), text.size());
+            }
+        });
+        double simdValid = timeMs([&] {
+            for (int r = 0; r < reps; ++r) {
+                ok += simdValidateUtf8(text.data(), text.size());
+            }
+        });
+        double scalarCount = timeMs([&] {
+            for (int r = 0; r < reps; ++r) {
+                cps += ScalarUtf8::count(text.data(), text.size());
+            }
+        });
+        double simdCount = timeMs([&] {
+            for (int r = 0; r < reps; ++r) {
+                cps += simdCountUtf8(text.data(), text.size());
+            }
+        });
+        doNotOptimize(ok);
+        doNotOptimize(cps);
+        std::size_t total = text.size() * reps;
+        std::println("{:<16} {:>9.2f} GB/s {:>9.2f} GB/s {:>9.2f} GB/s {:>9.2f} GB/s", name,
+                     gbps(total, scalarValid), gbps(total, simdValid), gbps(total, scalarCount), gbps(total, simdCount));
+    }
+
+    // Header-name lookups: short tokens that differ only in case.
+    std::string names[] = {"Content-Type", "content-type", "Accept-Encoding", "ACCEPT-ENCODING",
+                           "X-Forwarded-For-Original-Client-Address", "x-forwarded-for-original-client-address"};
+    std::size_t ops = bytes;
+    std::size_t equal = 0;
+    double scalarMs = timeMs([&] {
+        for (std::size_t i = 0; i < ops; ++i) {
+            equal += tolowerEquals(names[i % 6], names[(i + 1) % 6]);
+        }
+    });
+    double simdMs = timeMs([&] {
+        for (std::size_t i = 0; i < ops; ++i) {
+            const std::string& a = names[i % 6];
+            const std::string& b = names[(i + 1) % 6];
+            equal += a.size() == b.size() && simdEqualsIgnoreCase(a.data(), b.data(), a.size());
+        }
+    });
+    doNotOptimize(equal);
+    std::println("{:<16} {:>9.2f} ns/op (tolower loop) {:>9.2f} ns/op (simd)", "ignore-case ==", scalarMs * 1e6 / ops,
+                 simdMs * 1e6 / ops);
+}
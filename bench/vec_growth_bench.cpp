@@ -0,0 +1,43 @@
+#include <cstdint>
+#include <print>
+#include <vector>
+#include "../src/vector/mmap_allocator.hpp"
+#include "../src/vector/my_vec.hpp"
+#include "bench_util.hpp"
+
+// Growth time of push-only workloads for 8-byte POD records, from 1e6 elements up to the
+// limit passed as argv[1] (default 1e8; pass 1e9 on machines with more than 16 GB of RAM).
+
+template<typename Vec>
+double pushAll(std::size_t count) {
+    return timeMs([count] {
+        Vec vec;
+        for (std::size_t i = 0; i < count; ++i) {
+            vec.push_back(i);
+        }
+        doNotOptimize(vec.data());
+    });
+}
+
+template<typename Alloc>
+double pushAllVector(std::size_t count) {
+    return timeMs([count] {
+        Vector<std::uint64_t, Alloc> vec;
+        for (std::size_t i = 0; i < count; ++i) {
+            vec.pushBack(i);
+        }
+        doNotOptimize(vec.data());
+    });
+}
+
+int main(int argc, char** argv) {
+    std::size_t limit = argOr(argc, argv, 1, 100'000'000);
+
+    std::println("{:>12} {:>16} {:>16} {:>16}", "elements", "std::vector ms", "Vector ms", "Vector+mmap ms");
+    for (std::size_t count = 1'000'000; count <= limit; count *= 10) {
+        double stdMs = pushAll<std::vector<std::uint64_t>>(count);
+        double vecMs = pushAllVector<std::allocator<std::uint64_t>>(count);
+        double mapMs = pushAllVector<MmapAllocator<std::uint64_t>>(count);
+        std::println("{:>12} {:>16.1f} {:>16.1f} {:>16.1f}", count, stdMs, vecMs, mapMs);
+    }
+}
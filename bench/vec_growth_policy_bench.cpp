@@ -0,0 +1,43 @@
+#include <cstdint>
+#include <memory>
+#include <print>
+#include "../src/vector/growth_policy.hpp"
+#include "../src/vector/my_vec.hpp"
+#include "bench_util.hpp"
+
+// Pushes n 16-byte records under each growth policy and reports the counters collected by
+// VectorStats together with the unused capacity left at the end.
+
+namespace {
+    struct Record {
+        std::uint64_t key;
+        std::uint64_t value;
+    };
+
+    template<typename Growth>
+    void measure(const char* name, std::size_t count) {
+        Vector<Record, std::allocator<Record>, Growth, VectorStats> vec;
+        double ms = timeMs([&] {
+            for (std::size_t i = 0; i < count; ++i) {
+                vec.pushBack(Record{i, i});
+            }
+        });
+        const VectorStats& stats = vec.stats();
+        double slack = 100.0 * static_cast<double>(vec.capacity() - vec.size()) / static_cast<double>(vec.capacity());
+        std::println("{:<16} {:>12} {:>8} {:>14} {:>12} {:>8.1f} {:>10.1f}", name, count, stats.reallocations,
+                     stats.bytesCopied, stats.peakCapacity, slack, ms);
+    }
+} // namespace
+
+int main(int argc, char** argv) {
+    std::size_t limit = argOr(argc, argv, 1, 10'000'000);
+
+    std::println("{:<16} {:>12} {:>8} {:>14} {:>12} {:>8} {:>10}", "policy", "elements", "reallocs", "bytes copied",
+                 "peak cap", "slack %", "ms");
+    for (std::size_t count = 1000; count <= limit; count *= 10) {
+        std::size_t odd = count + count / 3;
+        measure<GrowDouble>("GrowDouble", odd);
+        measure<GrowOneAndHalf>("GrowOneAndHalf", odd);
+        measure<GrowSizeClass>("GrowSizeClass", odd);
+    }
+}
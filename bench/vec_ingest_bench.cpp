@@ -0,0 +1,87 @@
+#include <cstdio>
+#include <cstdlib>
+#include <fcntl.h>
+#include <print>
+#include <string>
+#include <unistd.h>
+#include "../src/vector/my_vec.hpp"
+#include "bench_util.hpp"
+
+// Reads a whole file into a Vector<char> in 1 MiB chunks, growing the buffer with resize (which
+// zero-fills), resizeForOverwrite and resizeAndOverwrite. argv[1] is the file size in MiB
+// (default 256); the file is written once to a temporary path and read from the page cache.
+
+namespace {
+    constexpr std::size_t chunk = std::size_t{1} << 20;
+
+    template<typename Grow>
+    std::size_t ingest(const char* path, Grow grow) {
+        int fd = ::open(path, O_RDONLY);
+        if (fd < 0) {
+            std::perror("open");
+            std::exit(1);
+        }
+        Vector<char> buf;
+        while (grow(fd, buf)) {
+        }
+        ::close(fd);
+        doNotOptimize(buf.data());
+        return buf.size();
+    }
+
+    bool viaResize(int fd, Vector<char>& buf) {
+        std::size_t old = buf.size();
+        if (buf.capacity() < old + chunk) {
+            buf.reserve(std::max(old + chunk, buf.capacity() * 2));
+        }
+        buf.resize(old + chunk);
+        ssize_t got = ::read(fd, buf.data() + old, chunk);
+        buf.resize(old + static_cast<std::size_t>(std::max<ssize_t>(got, 0)));
+        return got > 0;
+    }
+
+    bool viaResizeForOverwrite(int fd, Vector<char>& buf) {
+        std::size_t old = buf.size();
+        buf.resizeForOverwrite(old + chunk);
+        ssize_t got = ::read(fd, buf.data() + old, chunk);
+        buf.resizeForOverwrite(old + static_cast<std::size_t>(std::max<ssize_t>(got, 0)));
+        return got > 0;
+    }
+
+    bool viaResizeAndOverwrite(int fd, Vector<char>& buf) {
+        ssize_t got = 0;
+        std::size_t old = buf.size();
+        buf.resizeAndOverwrite(old + chunk, [&](char* data, std::size_t) {
+            got = ::read(fd, data + old, chunk);
+            return old + static_cast<std::size_t>(std::max<ssize_t>(got, 0));
+        });
+        return got > 0;
+    }
+} // namespace
+
+int main(int argc, char** argv) {
+    std::size_t mib = argOr(argc, argv, 1, 256);
+    std::string path = "/tmp/ds_vec_ingest_bench.bin";
+
+    {
+        Vector<char> block(chunk, 'x');
+        std::FILE* out = std::fopen(path.c_str(), "wb");
+        for (std::size_t i = 0; i < mib; ++i) {
+            std::fwrite(block.data(), 1, block.size(), out);
+        }
+        std::fclose(out);
+    }
+
+    std::size_t bytes = 0;
+    ingest(path.c_str(), viaResize);
+    double resizeMs = timeMs([&] { bytes = ingest(path.c_str(), viaResize); });
+    double overwriteMs = timeMs([&] { bytes = ingest(path.c_str(), viaResizeForOverwrite); });
+    double opMs = timeMs([&] { bytes = ingest(path.c_str(), viaResizeAndOverwrite); });
+    std::remove(path.c_str());
+
+    double gb = static_cast<double>(bytes) / 1e9;
+    std::println("{:<22} {:>10} {:>10}", "method", "ms", "GB/s");
+    std::println("{:<22} {:>10.1f} {:>10.2f}", "resize", resizeMs, gb / (resizeMs / 1e3));
+    std::println("{:<22} {:>10.1f} {:>10.2f}", "resizeForOverwrite", overwriteMs, gb / (overwriteMs / 1e3));
+    std::println("{:<22} {:>10.1f} {:>10.2f}", "resizeAndOverwrite", opMs, gb / (opMs / 1e3));
+}
@@ -0,0 +1,50 @@
+#include <algorithm>
+#include <cstdint>
+#include <print>
+#include <random>
+#include "../src/vector/my_vec.hpp"
+#include "bench_util.hpp"
+
+// find, count and erase-by-value over n elements (argv[1], default 1e8) against the std
+// algorithms, for 32-bit integers and doubles.
+
+namespace {
+    template<typename T>
+    void measure(const char* name, std::size_t n) {
+        std::mt19937_64 rng{1};
+        Vector<T> vec;
+        vec.resizeForOverwrite(n);
+        for (auto& v: vec) {
+            v = static_cast<T>(rng() % 1000);
+        }
+        T missing = static_cast<T>(5000);
+        T present = static_cast<T>(7);
+
+        std::size_t sink = 0;
+        double stdFind = timeMs([&] { sink += std::find(vec.begin(), vec.end(), missing) - vec.begin(); });
+        double simdFind = timeMs([&] { sink += vec.find(missing) - vec.begin(); });
+        double stdCount = timeMs([&] { sink += std::count(vec.begin(), vec.end(), present); });
+        double simdCount = timeMs([&] { sink += vec.count(present); });
+
+        Vector<T> copy = vec;
+        double stdErase = timeMs([&] { sink += std::remove(copy.begin(), copy.end(), present) - copy.begin(); });
+        double simdErase = timeMs([&] {
+            vec.erase(present);
+            sink += vec.size();
+        });
+        doNotOptimize(sink);
+
+        std::println("{:<8} {:>10.1f} {:>10.1f} {:>10.1f} {:>10.1f} {:>10.1f} {:>10.1f}", name, stdFind, simdFind,
+                     stdCount, simdCount, stdErase, simdErase);
+    }
+} // namespace
+
+int main(int argc, char** argv) {
+    std::size_t n = argOr(argc, argv, 1, 100'000'000);
+
+    std::println("{:<8} {:>10} {:>10} {:>10} {:>10} {:>10} {:>10}", "type", "std::find", "find", "std::count",
+                 "count", "std::rm", "erase");
+    measure<std::int32_t>("int32", n);
+    measure<std::uint64_t>("uint64", n);
+    measure<double>("double", n);
+}
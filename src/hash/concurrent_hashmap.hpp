@@ -0,0 +1,208 @@
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <shared_mutex>
+#include <utility>
+#include "hashmap.hpp"
+
+// A thread-safe map that splits its keys across independently locked HashMap shards, picked by
+// the key's hash, so threads working on different shards never contend. Each shard has a
+// reader-writer lock: lookups share it, and writers hold it exclusively for a single operation.
+//
+// Values are never handed out by reference, since another thread could erase them; get() copies
+// the value, and visit(), upsert() and compute() run a callback on it while the shard is locked.
+// Callbacks must not call back into the same map. Whole-map operations (size(), forEach(),
+// snapshot()) lock one shard at a time: each shard is seen in a consistent state, but writes to
+// other shards may land in between.
+template<typename Key, typename Val, typename Hash = std::hash<Key>, typename KeyEqual = std::equal_to<Key>,
+         RehashPolicy Rehash = RehashAtOnce>
+class ConcurrentHashMap {
+public:
+    using Map = HashMap<Key, Val, Hash, KeyEqual, Rehash>;
+
+    static constexpr std::size_t DEFAULT_SHARDS{64};
+
+    // shards is rounded up to a power of two.
+    explicit ConcurrentHashMap(std::size_t shards = DEFAULT_SHARDS)
+        : m_shardCount{std::bit_ceil(std::max<std::size_t>(shards, 1))},
+          m_shards{std::make_unique<Shard[]>(m_shardCount)} {}
+
+    ConcurrentHashMap(const ConcurrentHashMap&) = delete;
+    ConcurrentHashMap& operator=(const ConcurrentHashMap&) = delete;
+
+    [[nodiscard]] std::size_t shardCount() const noexcept { return m_shardCount; }
+
+    // A copy of the value for k, if present.
+    template<typename K>
+    [[nodiscard]] std::optional<Val> get(const K& k) const {
+        const Shard& shard = shardFor(k);
+        std::shared_lock lock{shard.mutex};
+        if (auto value = shard.map.get(k)) {
+            return value->get();
+        }
+        return std::nullopt;
+    }
+
+    template<typename K>
+    [[nodiscard]] bool contains(const K& k) const {
+        const Shard& shard = shardFor(k);
+        std::shared_lock lock{shard.mutex};
+        return shard.map.contains(k);
+    }
+
+    // Calls fn(const Val&) under a shared lock if k is present, without copying the value.
+    // Returns whether k was found.
+    template<typename K, typename Fn>
+    bool visit(const K& k, Fn&& fn) const {
+        const Shard& shard = shardFor(k);
+        std::shared_lock lock{shard.mutex};
+        if (auto value = shard.map.get(k)) {
+            std::invoke(fn, value->get());
+            return true;
+        }
+        return false;
+    }
+
+    // Inserts k, or overwrites its value if it is already present.
+    template<typename K>
+    void insert(K&& k, Val v) {
+        Shard& shard = shardFor(k);
+        std::unique_lock lock{shard.mutex};
+        shard.map.insert(std::forward<K>(k), std::move(v));
+    }
+
+    // Constructs the value from args if k is missing. Returns whether it was inserted.
+    template<typename K, typename... Args>
+    bool try_emplace(K&& k, Args&&... args) {
+        Shard& shard = shardFor(k);
+        std::unique_lock lock{shard.mutex};
+        return shard.map.try_emplace(std::forward<K>(k), std::forward<Args>(args)...).second;
+    }
+
+    // Atomically inserts k with v if it is missing, or calls fn(Val&) on the value already there.
+    // Returns whether v was inserted.
+    template<typename K, typename Fn>
+    bool upsert(K&& k, Val v, Fn&& fn) {
+        Shard& shard = shardFor(k);
+        std::unique_lock lock{shard.mutex};
+        auto [it, inserted] = shard.map.try_emplace(std::forward<K>(k), std::move(v));
+        if (!inserted) {
+            std::invoke(fn, it->value);
+        }
+        return inserted;
+    }
+
+    // Atomically replaces the entry for k with fn(Val* current), where current is nullptr if k is
+    // missing. fn returns a std::optional<Val>: a value is stored under k, nullopt erases k (or
+    // leaves it missing). Returns whether k is present afterwards.
+    template<typename K, typename Fn>
+    bool compute(K&& k, Fn&& fn) {
+        Shard& shard = shardFor(k);
+        std::unique_lock lock{shard.mutex};
+        auto current = shard.map.get(k);
+        std::optional<Val> next = std::invoke(fn, current ? &current->get() : static_cast<Val*>(nullptr));
+        if (next) {
+            if (current) {
+                current->get() = std::move(*next);
+            } else {
+                shard.map.try_emplace(std::forward<K>(k), std::move(*next));
+            }
+            return true;
+        }
+        if (current) {
+            shard.map.erase(k);
+        }
+        return false;
+    }
+
+    template<typename K>
+    bool erase(const K& k) {
+        Shard& shard = shardFor(k);
+        std::unique_lock lock{shard.mutex};
+        return shard.map.erase(k);
+    }
+
+    // Total size, summed shard by shard; exact only when no writer is running.
+    [[nodiscard]] std::size_t size() const {
+        std::size_t total = 0;
+        for (std::size_t i = 0; i < m_shardCount; ++i) {
+            std::shared_lock lock{m_shards[i].mutex};
+            total += m_shards[i].map.size();
+        }
+        return total;
+    }
+
+    [[nodiscard]] bool empty() const { return size() == 0; }
+
+    // Makes room for about n elements in total, spread evenly over the shards.
+    void reserve(std::size_t n) {
+        std::size_t perShard = n / m_shardCount + 1;
+        for (std::size_t i = 0; i < m_shardCount; ++i) {
+            std::unique_lock lock{m_shards[i].mutex};
+            m_shards[i].map.reserve(perShard);
+        }
+    }
+
+    void clear() {
+        for (std::size_t i = 0; i < m_shardCount; ++i) {
+            std::unique_lock lock{m_shards[i].mutex};
+            m_shards[i].map = Map{};
+        }
+    }
+
+    // Calls fn(const Key&, const Val&) for every element, holding one shard's shared lock at a
+    // time.
+    template<typename Fn>
+    void forEach(Fn&& fn) const {
+        for (std::size_t i = 0; i < m_shardCount; ++i) {
+            std::shared_lock lock{m_shards[i].mutex};
+            for (const auto& kvp: m_shards[i].map) {
+                std::invoke(fn, kvp.key, kvp.value);
+            }
+        }
+    }
+
+    // Copies every element into a plain HashMap, one shard at a time.
+    [[nodiscard]] Map snapshot() const {
+        Map copy;
+        copy.reserve(size());
+        forEach([&](const Key& key, const Val& value) { copy.try_emplace(key, value); });
+        return copy;
+    }
+
+private:
+    // Each shard sits on its own cache lines so that locking one does not invalidate its neighbours.
+    struct alignas(64) Shard {
+        mutable std::shared_mutex mutex;
+        Map map;
+    };
+
+    std::size_t m_shardCount;
+    std::unique_ptr<Shard[]> m_shards;
+    Hash m_hash{};
+
+    // HashMap takes its group index and tag from a mix of the low and high hash bits; the shard
+    // comes from the top bits of a different multiplier, so shards do not thin out any group.
+    template<typename K>
+    std::size_t shardIndex(const K& k) const {
+        std::uint64_t h = static_cast<std::uint64_t>(m_hash(k)) * 0xD6E8FEB86659FD93ull;
+        return static_cast<std::size_t>(h >> 32) & (m_shardCount - 1);
+    }
+
+    template<typename K>
+    Shard& shardFor(const K& k) {
+        return m_shards[shardIndex(k)];
+    }
+
+    template<typename K>
+    const Shard& shardFor(const K& k) const {
+        return m_shards[shardIndex(k)];
+    }
+};
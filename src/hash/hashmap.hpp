@@ -1,120 +1,807 @@
 #pragma once
 
+#include <algorithm>
 #include <bit>
-#include <cmath>
+#include <concepts>
 #include <cstddef>
-#include <deque>
+#include <cstdint>
+#include <cstdlib>
 #include <functional>
+#include <iterator>
+#include <memory>
+#include <new>
 #include <optional>
-#include <vector>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
 
-template<typename Key, typename Val, typename Hash = std::hash<Key>>
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+// A rehash policy decides how HashMap moves its elements into a new table once the current one is
+// at its load limit: groupsPerStep == 0 moves them all at once, anything else moves that many
+// 16-slot groups of the old table per insert.
+template<typename P>
+concept RehashPolicy = requires {
+    { P::groupsPerStep } -> std::convertible_to<std::size_t>;
+};
+
+// The insert that crosses the load limit rebuilds the whole table before it returns.
+struct RehashAtOnce {
+    static constexpr std::size_t groupsPerStep = 0;
+};
+
+// Redis-style incremental rehashing: the old table stays alive next to the new one, and every
+// insert migrates the next two groups of it, so no single insert pays for moving the whole map.
+// Until the old table is drained, lookups and erases consult both tables.
+struct RehashIncremental {
+    static constexpr std::size_t groupsPerStep = 2;
+};
+
+// An open-addressing hash map in the style of Abseil's Swiss tables. Slots live in one flat array,
+// shadowed by an array of control bytes: EMPTY, DELETED (a tombstone left by erase) or, for a full
+// slot, the high bit plus the low 7 bits of the key's hash. Lookups probe 16 control bytes at a
+// time, compare them all against the tag with one SSE2 compare, and only touch slots whose tag
+// matches. The capacity is a power of two, so the probe start is a mask rather than a %, and
+// groups are visited in triangular order, which covers every group. The table grows at 7/8
+// occupancy.
+//
+// When both Hash and KeyEqual declare is_transparent (StringHash with std::equal_to<>, say),
+// lookups accept anything they can hash and compare, such as a string_view for String keys, and
+// the key is only constructed when an element is actually inserted. Inserting may rehash, which
+// moves elements and invalidates all iterators and references; erase invalidates only the erased
+// element.
+template<typename Key, typename Val, typename Hash = std::hash<Key>, typename KeyEqual = std::equal_to<Key>,
+         RehashPolicy Rehash = RehashAtOnce>
 class HashMap {
-private:
+public:
     struct Kvp {
         Key key;
         Val value;
 
-        constexpr Kvp(Key k, Val v) : key(std::move(k)), value(std::move(v)) {}
-        constexpr auto operator<=>(const Kvp&) const noexcept = default;
+        template<typename K, typename... Args>
+        Kvp(std::piecewise_construct_t, K&& k, Args&&... args)
+            : key(std::forward<K>(k)), value(std::forward<Args>(args)...) {}
+    };
+
+private:
+    // K can be looked up directly, without first being converted to a Key.
+    template<typename K>
+    static constexpr bool isLookupKey = std::same_as<std::remove_cvref_t<K>, Key> ||
+                                        requires {
+                                            typename Hash::is_transparent;
+                                            typename KeyEqual::is_transparent;
+                                        };
+
+    using ctrl_t = std::int8_t;
+    // EMPTY is zero so that a new control array can come straight from calloc, which hands out
+    // large blocks as untouched zero pages: growing to any size costs no pass over the bytes.
+    static constexpr ctrl_t EMPTY{0};
+    static constexpr ctrl_t DELETED{1};
+    static constexpr std::size_t GROUP{16};
+    static constexpr std::size_t MIN_CAPACITY{16};
+    static constexpr std::size_t npos{static_cast<std::size_t>(-1)};
+    static constexpr bool INCREMENTAL{Rehash::groupsPerStep > 0};
+    // Keys that locateMany keeps in flight: enough outstanding misses to hide memory latency,
+    // few enough to fit the core's line fill buffers.
+    static constexpr std::size_t PREFETCH_BATCH{16};
+
+    // Full slots are the only ones with the high bit set.
+    static constexpr bool isFull(ctrl_t ctrl) noexcept { return ctrl < 0; }
+
+    // The 16 control bytes of one group, with bitmasks of the bytes that match a query.
+    class Group {
+    public:
+        explicit Group(const ctrl_t* ctrl) noexcept {
+#if defined(__SSE2__)
+            m_ctrl = _mm_loadu_si128(reinterpret_cast<const __m128i*>(ctrl));
+#else
+            std::copy_n(ctrl, GROUP, m_ctrl);
+#endif
+        }
+
+        [[nodiscard]] std::uint32_t match(ctrl_t tag) const noexcept {
+#if defined(__SSE2__)
+            return static_cast<std::uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(m_ctrl, _mm_set1_epi8(tag))));
+#else
+            std::uint32_t bits = 0;
+            for (std::size_t i = 0; i < GROUP; ++i) {
+                bits |= static_cast<std::uint32_t>(m_ctrl[i] == tag) << i;
+            }
+            return bits;
+#endif
+        }
+
+        [[nodiscard]] std::uint32_t matchEmpty() const noexcept { return match(EMPTY); }
+
+        [[nodiscard]] std::uint32_t matchFree() const noexcept {
+#if defined(__SSE2__)
+            return static_cast<std::uint32_t>(~_mm_movemask_epi8(m_ctrl)) & 0xFFFF;
+#else
+            std::uint32_t bits = 0;
+            for (std::size_t i = 0; i < GROUP; ++i) {
+                bits |= static_cast<std::uint32_t>(!isFull(m_ctrl[i])) << i;
+            }
+            return bits;
+#endif
+        }
+
+    private:
+#if defined(__SSE2__)
+        __m128i m_ctrl;
+#else
+        ctrl_t m_ctrl[GROUP];
+#endif
+    };
+
+    // Control bytes and the slots they describe. size counts the full slots, deleted the tombstones.
+    struct Table {
+        ctrl_t* ctrl{nullptr};
+        Kvp* slots{nullptr};
+        std::size_t capacity{0};
+        std::size_t size{0};
+        std::size_t deleted{0};
+    };
+
+    // Walks the slots in table order, skipping the free ones; while rehashing, the old table and
+    // then the new one. Elements must not have their key changed through an iterator.
+    template<bool Const>
+    class Iter {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = Kvp;
+        using difference_type = std::ptrdiff_t;
+        using pointer = std::conditional_t<Const, const Kvp*, Kvp*>;
+        using reference = std::conditional_t<Const, const Kvp&, Kvp&>;
+
+        Iter() noexcept = default;
+
+        // iterator converts to const_iterator. A template, so that it is never Iter<false>'s copy
+        // constructor.
+        template<bool IsConst = Const>
+            requires IsConst
+        Iter(const Iter<false>& other) noexcept
+            : m_ctrl{other.m_ctrl}, m_end{other.m_end}, m_slot{other.m_slot}, m_nextCtrl{other.m_nextCtrl},
+              m_nextEnd{other.m_nextEnd}, m_nextSlot{other.m_nextSlot} {}
+
+        reference operator*() const noexcept { return *m_slot; }
+        pointer operator->() const noexcept { return m_slot; }
+
+        Iter& operator++() noexcept {
+            ++m_ctrl;
+            ++m_slot;
+            skipFree();
+            return *this;
+        }
+
+        Iter operator++(int) noexcept {
+            Iter tmp{*this};
+            ++*this;
+            return tmp;
+        }
+
+        friend bool operator==(const Iter& a, const Iter& b) noexcept { return a.m_ctrl == b.m_ctrl; }
+
+    private:
+        friend class HashMap;
+        template<bool>
+        friend class Iter;
+
+        Iter(const ctrl_t* ctrl, const ctrl_t* end, pointer slot, const ctrl_t* nextCtrl, const ctrl_t* nextEnd,
+             pointer nextSlot) noexcept
+            : m_ctrl{ctrl}, m_end{end}, m_slot{slot}, m_nextCtrl{nextCtrl}, m_nextEnd{nextEnd}, m_nextSlot{nextSlot} {
+            skipFree();
+        }
+
+        void skipFree() noexcept {
+            while (true) {
+                while (m_ctrl != m_end && !isFull(*m_ctrl)) {
+                    ++m_ctrl;
+                    ++m_slot;
+                }
+                if (m_ctrl != m_end || !m_nextCtrl) {
+                    return;
+                }
+                m_ctrl = std::exchange(m_nextCtrl, nullptr);
+                m_end = m_nextEnd;
+                m_slot = m_nextSlot;
+            }
+        }
+
+        const ctrl_t* m_ctrl{nullptr};
+        const ctrl_t* m_end{nullptr};
+        pointer m_slot{nullptr};
+        // The table to continue with once this one ends, if any.
+        const ctrl_t* m_nextCtrl{nullptr};
+        const ctrl_t* m_nextEnd{nullptr};
+        pointer m_nextSlot{nullptr};
     };
 
 public:
-    constexpr HashMap(std::size_t cap = 16) : m_table(cap) {}
+    using key_type = Key;
+    using mapped_type = Val;
+    using value_type = Kvp;
+    using iterator = Iter<false>;
+    using const_iterator = Iter<true>;
 
-    constexpr auto operator<=>(const HashMap&) const noexcept = default;
+    HashMap(std::size_t cap = MIN_CAPACITY) : m_table{allocate(normalizeCapacity(cap))} {}
 
-    Val& operator[](const Key& k) {
-        auto& bucket = m_table[m_hash(k) % m_table.size()];
-        if (auto it = std::ranges::find(bucket, k, &Kvp::key); it != bucket.end()) {
-            return it->value;
+    HashMap(const HashMap& other) : m_cursor{other.m_cursor}, m_hash{other.m_hash}, m_eq{other.m_eq} {
+        m_table = copyTable(other.m_table);
+        try {
+            m_old = copyTable(other.m_old);
+        } catch (...) {
+            destroyTable(m_table);
+            throw;
         }
     }
 
-    void reserve(size_t n) {
-        size_t needed_buckets = std::ceil(n / m_loadFactor);
-        if (needed_buckets > m_table.size()) {
-            rehash(needed_buckets);
+    HashMap(HashMap&& other) noexcept
+        : m_table{std::exchange(other.m_table, {})}, m_old{std::exchange(other.m_old, {})},
+          m_cursor{std::exchange(other.m_cursor, 0)}, m_hash{std::move(other.m_hash)}, m_eq{std::move(other.m_eq)} {}
+
+    HashMap& operator=(const HashMap& other) {
+        if (this != &other) {
+            HashMap copy{other};
+            swap(copy);
         }
+        return *this;
     }
 
-    void shrink_to_fit() {
-        size_t optimal_buckets = std::ceil(m_size / m_loadFactor);
-        optimal_buckets = std::max(optimal_buckets, size_t{16});
-        if (optimal_buckets < m_table.size()) {
-            rehash(optimal_buckets);
+    HashMap& operator=(HashMap&& other) noexcept {
+        if (this != &other) {
+            HashMap moved{std::move(other)};
+            swap(moved);
         }
+        return *this;
     }
 
-    constexpr float loadFactor() const { return static_cast<float>(m_size) / m_table.size(); }
+    ~HashMap() {
+        destroyTable(m_table);
+        destroyTable(m_old);
+    }
+
+    void swap(HashMap& other) noexcept {
+        std::swap(m_table, other.m_table);
+        std::swap(m_old, other.m_old);
+        std::swap(m_cursor, other.m_cursor);
+        std::swap(m_hash, other.m_hash);
+        std::swap(m_eq, other.m_eq);
+    }
 
-    void rehash(size_t n) {
-        n = std::max(n, size_t{16});
-        n = std::bit_ceil(n);
-        std::vector<std::deque<Kvp>> new_table(n);
-        for (auto& bucket: m_table) {
-            for (auto& kvp: bucket) {
-                new_table[m_hash(kvp.key) % n].push_back(std::move(kvp));
+    iterator begin() noexcept { return iteratorAt<iterator>(rehashing() ? m_old : m_table, 0); }
+    iterator end() noexcept { return iteratorAt<iterator>(m_table, m_table.capacity); }
+    const_iterator begin() const noexcept { return iteratorAt<const_iterator>(rehashing() ? m_old : m_table, 0); }
+    const_iterator end() const noexcept { return iteratorAt<const_iterator>(m_table, m_table.capacity); }
+    const_iterator cbegin() const noexcept { return begin(); }
+    const_iterator cend() const noexcept { return end(); }
+
+    // Maps with the same keys, each mapped to equal values.
+    friend bool operator==(const HashMap& lhs, const HashMap& rhs)
+        requires std::equality_comparable<Val>
+    {
+        if (lhs.size() != rhs.size()) {
+            return false;
+        }
+        for (const Kvp& kvp: lhs) {
+            const Kvp* other = rhs.locate(kvp.key);
+            if (!other || !(other->value == kvp.value)) {
+                return false;
             }
         }
+        return true;
+    }
 
-        m_table = std::move(new_table);
+    // The value for k, default-constructed and inserted if k is missing.
+    template<typename K>
+    Val& operator[](K&& k) {
+        return emplaceKey(std::forward<K>(k)).first->value;
     }
 
-    std::optional<const Val&> get(this const auto& self, const Key& k) {
-        auto& bucket = self.m_table[self.m_hash(k) % self.m_table.size()];
-        if (auto it = std::ranges::find(bucket, k, &Kvp::key); it != bucket.end()) {
-            return it->value;
+    // Makes room for n elements without further rehashing.
+    void reserve(std::size_t n) {
+        std::size_t needed = capacityFor(n);
+        if (needed > m_table.capacity) {
+            rehash(needed);
         }
-        return std::nullopt;
     }
 
-    void insert(const Key& k, Val v) {
-        if (m_size >= m_table.size() * m_loadFactor) {
-            resize();
+    void shrink_to_fit() {
+        std::size_t optimal = capacityFor(size());
+        if (optimal < m_table.capacity) {
+            rehash(optimal);
+        }
+    }
+
+    float loadFactor() const {
+        return m_table.capacity ? static_cast<float>(size()) / static_cast<float>(m_table.capacity) : 0.0f;
+    }
+
+    // Rebuilds the table with at least n slots (and enough for the current elements), dropping
+    // all tombstones. Always done at once, finishing an incremental rehash first.
+    void rehash(std::size_t n) {
+        finishRehash();
+        rebuild(std::max(normalizeCapacity(n), capacityFor(size())));
+    }
+
+    // Whether an incremental rehash is in progress, with an old table still allocated.
+    [[nodiscard]] bool rehashing() const noexcept { return m_old.capacity != 0; }
+
+    // Migrates up to groups groups of the old table without inserting anything, e.g. from an idle
+    // loop. Returns whether the rehash is still in progress.
+    bool rehashStep(std::size_t groups) {
+        if (rehashing()) {
+            migrate(groups);
+        }
+        return rehashing();
+    }
+
+    template<typename K>
+    iterator find(const K& k) {
+        const Kvp* kvp = locate(k);
+        return kvp ? iteratorTo<iterator>(kvp) : end();
+    }
+
+    template<typename K>
+    const_iterator find(const K& k) const {
+        const Kvp* kvp = locate(k);
+        return kvp ? iteratorTo<const_iterator>(kvp) : end();
+    }
+
+    template<typename K>
+    std::optional<std::reference_wrapper<const Val>> get(const K& k) const {
+        if (const Kvp* kvp = locate(k)) {
+            return std::cref(kvp->value);
         }
+        return std::nullopt;
+    }
 
-        auto& bucket = m_table[m_hash(k) % m_table.size()];
-        if (auto it = std::ranges::find(bucket, k, &Kvp::key); it != bucket.end()) {
-            it->value = std::move(v);
-            return;
+    template<typename K>
+    std::optional<std::reference_wrapper<Val>> get(const K& k) {
+        if (Kvp* kvp = locate(k)) {
+            return std::ref(kvp->value);
         }
-        bucket.emplace_back(k, std::move(v));
-        ++m_size;
+        return std::nullopt;
+    }
+
+    template<typename K>
+    bool contains(const K& k) const {
+        return locate(k) != nullptr;
+    }
+
+    // Batched get for probing many keys at once, as a hash join does: out[i] is set to the value
+    // of keys[i], or nullptr if it is missing. On tables larger than the cache this overlaps the
+    // misses of neighbouring keys instead of paying for them one by one. out must be at least as
+    // long as keys. Returns the number of keys found.
+    std::size_t getMany(std::span<const Key> keys, std::span<const Val*> out) const {
+        return locateMany(keys, out.size(),
+                          [&](std::size_t i, const Kvp* kvp) { out[i] = kvp ? &kvp->value : nullptr; });
+    }
+
+    std::size_t getMany(std::span<const Key> keys, std::span<Val*> out) {
+        return locateMany(keys, out.size(), [&](std::size_t i, Kvp* kvp) { out[i] = kvp ? &kvp->value : nullptr; });
+    }
+
+    // Batched contains, with the same contract as getMany.
+    std::size_t containsMany(std::span<const Key> keys, std::span<bool> out) const {
+        return locateMany(keys, out.size(), [&](std::size_t i, const Kvp* kvp) { out[i] = kvp != nullptr; });
+    }
+
+    // Inserts k, or overwrites its value if it is already present.
+    template<typename K>
+    void insert(K&& k, Val v) {
+        insert_or_assign(std::forward<K>(k), std::move(v));
     }
 
-    bool contains(this const auto& self, const Key& k) {
-        auto& bucket = self.m_table[self.m_hash(k) % self.m_table.size()];
-        return std::ranges::find(bucket, k, &Kvp::key) != bucket.end();
+    // Constructs the value from args in place if k is missing; otherwise leaves the map, and args,
+    // untouched. The key is hashed once either way.
+    template<typename K, typename... Args>
+    std::pair<iterator, bool> try_emplace(K&& k, Args&&... args) {
+        auto [kvp, inserted] = emplaceKey(std::forward<K>(k), std::forward<Args>(args)...);
+        return {iteratorTo<iterator>(kvp), inserted};
     }
 
-    bool erase(const Key& k) {
-        auto& bucket = m_table[m_hash(k) % m_table.size()];
-        if (auto it = std::ranges::find(bucket, k, &Kvp::key); it != bucket.end()) {
-            bucket.erase(it);
-            --m_size;
-            return true;
+    // Like try_emplace. Unlike std::unordered_map::emplace, nothing is constructed when the key
+    // is already present.
+    template<typename K, typename... Args>
+    std::pair<iterator, bool> emplace(K&& k, Args&&... args) {
+        return try_emplace(std::forward<K>(k), std::forward<Args>(args)...);
+    }
+
+    // Inserts k mapped to obj, or assigns obj to the value already there.
+    template<typename K, typename M>
+    std::pair<iterator, bool> insert_or_assign(K&& k, M&& obj) {
+        auto [kvp, inserted] = emplaceKey(std::forward<K>(k), std::forward<M>(obj));
+        if (!inserted) {
+            kvp->value = std::forward<M>(obj);
         }
-        return false;
+        return {iteratorTo<iterator>(kvp), inserted};
     }
 
-    constexpr std::size_t size() const { return m_size; }
-    constexpr bool empty() const { return m_size == 0; }
-    constexpr std::size_t bucket_count() const { return m_table.size(); }
+    template<typename K>
+        requires(!std::is_convertible_v<const K&, const_iterator>)
+    bool erase(const K& k) {
+        const Kvp* kvp = locate(k);
+        if (!kvp) {
+            return false;
+        }
+        Table& table = tableOf(kvp);
+        eraseAt(table, static_cast<std::size_t>(kvp - table.slots));
+        return true;
+    }
+
+    // Erases the element at pos and returns an iterator to the one after it.
+    iterator erase(const_iterator pos) {
+        Table& table = tableOf(pos.m_slot);
+        auto i = static_cast<std::size_t>(pos.m_slot - table.slots);
+        eraseAt(table, i);
+        return iteratorAt<iterator>(table, i);
+    }
+
+    constexpr std::size_t size() const { return m_table.size + m_old.size; }
+    constexpr bool empty() const { return size() == 0; }
+    constexpr std::size_t bucket_count() const { return m_table.capacity; }
 
 private:
-    std::vector<std::deque<Kvp>> m_table;
-    std::size_t m_size{0};
-    static constexpr float m_loadFactor{0.75f};
+    Table m_table;
+    // The table an incremental rehash is draining, empty otherwise. Its slots before m_cursor have
+    // all been migrated.
+    Table m_old;
+    std::size_t m_cursor{0};
     Hash m_hash{};
+    KeyEqual m_eq{};
 
-    void resize() {
-        std::vector<std::deque<Kvp>> new_table(m_table.size() * 2);
-        for (auto& bucket: m_table) {
-            for (auto& kvp: bucket) {
-                new_table[m_hash(kvp.key) % new_table.size()].push_back(std::move(kvp));
+    static constexpr std::size_t normalizeCapacity(std::size_t n) noexcept {
+        return std::bit_ceil(std::max(n, MIN_CAPACITY));
+    }
+
+    // Occupied slots, tombstones included, allowed before the table must grow.
+    static constexpr std::size_t maxLoad(std::size_t cap) noexcept { return cap - cap / 8; }
+
+    static constexpr std::size_t capacityFor(std::size_t n) noexcept {
+        std::size_t cap = MIN_CAPACITY;
+        while (maxLoad(cap) < n) {
+            cap *= 2;
+        }
+        return cap;
+    }
+
+    // Spreads the hash so that identity hashes of small integers still differ in the bits used
+    // for the group index and for the tag.
+    template<typename K>
+    std::size_t hashOf(const K& k) const {
+        std::uint64_t h = static_cast<std::uint64_t>(m_hash(k)) * 0x9E3779B97F4A7C15ull;
+        return static_cast<std::size_t>(h ^ (h >> 32));
+    }
+
+    static ctrl_t tagOf(std::size_t hash) noexcept { return static_cast<ctrl_t>((hash & 0x7F) | 0x80); }
+
+    static std::size_t firstGroup(const Table& table, std::size_t hash) noexcept {
+        return (hash >> 7) & (table.capacity / GROUP - 1);
+    }
+
+    // An iterator at slot i of table; positions in the old table continue into the new one.
+    template<typename It>
+    It iteratorAt(const Table& table, std::size_t i) const noexcept {
+        if (&table == &m_old) {
+            return It{table.ctrl + i,
+                      table.ctrl + table.capacity,
+                      table.slots + i,
+                      m_table.ctrl,
+                      m_table.ctrl + m_table.capacity,
+                      m_table.slots};
+        }
+        return It{table.ctrl + i, table.ctrl + table.capacity, table.slots + i, nullptr, nullptr, nullptr};
+    }
+
+    template<typename It>
+    It iteratorTo(const Kvp* kvp) const noexcept {
+        const Table& table = tableOf(kvp);
+        return iteratorAt<It>(table, static_cast<std::size_t>(kvp - table.slots));
+    }
+
+    // The table holding the slot kvp.
+    Table& tableOf(const Kvp* kvp) noexcept { return owns(m_old, kvp) ? m_old : m_table; }
+    const Table& tableOf(const Kvp* kvp) const noexcept { return owns(m_old, kvp) ? m_old : m_table; }
+
+    static bool owns(const Table& table, const Kvp* kvp) noexcept {
+        std::less<const Kvp*> less;
+        return table.capacity != 0 && !less(kvp, table.slots) && less(kvp, table.slots + table.capacity);
+    }
+
+    // The slot holding k, or nullptr. A K that is not a lookup key is converted to a Key first.
+    template<typename K>
+    Kvp* locate(const K& k) const {
+        if constexpr (isLookupKey<K>) {
+            return empty() ? nullptr : locateHashed(k, hashOf(k));
+        } else {
+            return locate<Key>(k);
+        }
+    }
+
+    template<typename K>
+    Kvp* locateHashed(const K& k, std::size_t hash) const {
+        if (std::size_t i = findIndex(m_table, k, hash); i != npos) {
+            return m_table.slots + i;
+        }
+        if constexpr (INCREMENTAL) {
+            if (m_old.size != 0) {
+                if (std::size_t i = findIndex(m_old, k, hash); i != npos) {
+                    return m_old.slots + i;
+                }
+            }
+        }
+        return nullptr;
+    }
+
+    // Looks keys up PREFETCH_BATCH at a time, in three passes over each batch so that its cache
+    // misses are outstanding together: hash every key and prefetch its first control group, match
+    // the tags and prefetch the first candidate slot, then compare the keys. A lookup that has to
+    // go past its first group, or into the old table of an incremental rehash, finishes with the
+    // ordinary probe. Calls onResult(i, slot or nullptr) for each key, in order.
+    template<typename Fn>
+    std::size_t locateMany(std::span<const Key> keys, std::size_t outSize, Fn onResult) const {
+        if (outSize < keys.size()) {
+            throw std::invalid_argument{"HashMap: batched lookup output is shorter than its keys"};
+        }
+        std::size_t found = 0;
+        if (empty()) {
+            for (std::size_t i = 0; i < keys.size(); ++i) {
+                onResult(i, nullptr);
+            }
+            return found;
+        }
+        std::size_t hashes[PREFETCH_BATCH];
+        std::uint32_t candidates[PREFETCH_BATCH];
+        bool groupHasEmpty[PREFETCH_BATCH];
+        for (std::size_t base = 0; base < keys.size(); base += PREFETCH_BATCH) {
+            std::size_t n = std::min(PREFETCH_BATCH, keys.size() - base);
+            for (std::size_t j = 0; j < n; ++j) {
+                hashes[j] = hashOf(keys[base + j]);
+                prefetch(m_table.ctrl + firstGroup(m_table, hashes[j]) * GROUP);
+            }
+            for (std::size_t j = 0; j < n; ++j) {
+                std::size_t start = firstGroup(m_table, hashes[j]) * GROUP;
+                Group group{m_table.ctrl + start};
+                candidates[j] = group.match(tagOf(hashes[j]));
+                groupHasEmpty[j] = group.matchEmpty() != 0;
+                if (candidates[j] != 0) {
+                    prefetch(m_table.slots + start + static_cast<std::size_t>(std::countr_zero(candidates[j])));
+                }
+            }
+            for (std::size_t j = 0; j < n; ++j) {
+                const Key& k = keys[base + j];
+                std::size_t start = firstGroup(m_table, hashes[j]) * GROUP;
+                Kvp* kvp = nullptr;
+                for (std::uint32_t bits = candidates[j]; bits; bits &= bits - 1) {
+                    std::size_t i = start + static_cast<std::size_t>(std::countr_zero(bits));
+                    if (m_eq(m_table.slots[i].key, k)) {
+                        kvp = m_table.slots + i;
+                        break;
+                    }
+                }
+                if (!kvp && (!groupHasEmpty[j] || m_old.size != 0)) {
+                    kvp = locateHashed(k, hashes[j]);
+                }
+                found += kvp != nullptr;
+                onResult(base + j, kvp);
+            }
+        }
+        return found;
+    }
+
+    // Starts loading the cache line at p; a no-op where there is no prefetch instruction.
+    static void prefetch(const void* p) noexcept {
+#if defined(__SSE2__)
+        _mm_prefetch(static_cast<const char*>(p), _MM_HINT_T0);
+#elif defined(__GNUC__)
+        __builtin_prefetch(p);
+#endif
+    }
+
+    template<typename K>
+    std::size_t findIndex(const Table& table, const K& k, std::size_t hash) const {
+        if (table.capacity == 0) {
+            return npos;
+        }
+        ctrl_t tag = tagOf(hash);
+        std::size_t groupMask = table.capacity / GROUP - 1;
+        std::size_t g = firstGroup(table, hash);
+        for (std::size_t step = 1;; ++step) {
+            Group group{table.ctrl + g * GROUP};
+            for (std::uint32_t bits = group.match(tag); bits; bits &= bits - 1) {
+                std::size_t i = g * GROUP + static_cast<std::size_t>(std::countr_zero(bits));
+                if (m_eq(table.slots[i].key, k)) {
+                    return i;
+                }
+            }
+            if (group.matchEmpty() != 0) {
+                return npos;
+            }
+            g = (g + step) & groupMask;
+        }
+    }
+
+    // First EMPTY or DELETED slot on hash's probe sequence. The table always has an EMPTY slot.
+    static std::size_t findFree(const Table& table, std::size_t hash) noexcept {
+        std::size_t groupMask = table.capacity / GROUP - 1;
+        std::size_t g = firstGroup(table, hash);
+        for (std::size_t step = 1;; ++step) {
+            if (std::uint32_t bits = Group{table.ctrl + g * GROUP}.matchFree(); bits != 0) {
+                return g * GROUP + static_cast<std::size_t>(std::countr_zero(bits));
+            }
+            g = (g + step) & groupMask;
+        }
+    }
+
+    // The slot of k, and whether it was just inserted with a value built from args. k is hashed
+    // once; the Key is constructed from it only when inserting.
+    template<typename K, typename... Args>
+    std::pair<Kvp*, bool> emplaceKey(K&& k, Args&&... args) {
+        if constexpr (isLookupKey<K>) {
+            std::size_t hash = hashOf(k);
+            if (Kvp* kvp = locateHashed(k, hash)) {
+                return {kvp, false};
+            }
+            std::size_t i = prepareInsert(hash);
+            Kvp* kvp = m_table.slots + i;
+            std::construct_at(kvp, std::piecewise_construct, std::forward<K>(k), std::forward<Args>(args)...);
+            commitInsert(m_table, i, hash);
+            return {kvp, true};
+        } else {
+            return emplaceKey<Key>(std::forward<K>(k), std::forward<Args>(args)...);
+        }
+    }
+
+    // Picks the slot for a new element, first taking a migration step if rehashing and growing if
+    // the table is at its load limit. Elements still in the old table count against the new
+    // one's limit, since they will end up there. When at least half of the limit is tombstones,
+    // rehashing into the same capacity frees enough room.
+    std::size_t prepareInsert(std::size_t hash) {
+        if (m_table.capacity == 0) {
+            m_table = allocate(MIN_CAPACITY);
+        }
+        if constexpr (INCREMENTAL) {
+            if (rehashing()) {
+                migrate(Rehash::groupsPerStep);
+            }
+        }
+        std::size_t limit = maxLoad(m_table.capacity);
+        if (size() + m_table.deleted + 1 > limit) {
+            std::size_t cap = size() + 1 <= limit / 2 ? m_table.capacity : m_table.capacity * 2;
+            if constexpr (INCREMENTAL) {
+                // Normally a no-op: the old table drains long before the new one fills up.
+                finishRehash();
+                m_old = std::exchange(m_table, allocate(cap));
+                m_cursor = 0;
+                migrate(Rehash::groupsPerStep);
+            } else {
+                rebuild(cap);
+            }
+        }
+        return findFree(m_table, hash);
+    }
+
+    static void commitInsert(Table& table, std::size_t i, std::size_t hash) noexcept {
+        if (table.ctrl[i] == DELETED) {
+            --table.deleted;
+        }
+        table.ctrl[i] = tagOf(hash);
+        ++table.size;
+    }
+
+    static void eraseAt(Table& table, std::size_t i) noexcept {
+        std::destroy_at(table.slots + i);
+        --table.size;
+        // A group that still has an EMPTY byte has never been full since the last rehash, so no
+        // probe has ever continued past it and the slot can go back to EMPTY. Otherwise later
+        // keys may have probed through it, and it must become a tombstone.
+        if (Group{table.ctrl + (i & ~(GROUP - 1))}.matchEmpty() != 0) {
+            table.ctrl[i] = EMPTY;
+        } else {
+            table.ctrl[i] = DELETED;
+            ++table.deleted;
+        }
+    }
+
+    // Moves the elements of the next groups groups of the old table into the new one, and frees
+    // the old table once it is empty. Migrated slots are erased like any other, so the keys not
+    // yet migrated stay reachable by their probe sequences.
+    void migrate(std::size_t groups) {
+        std::size_t left = m_old.capacity - m_cursor;
+        std::size_t stop = groups >= left / GROUP ? m_old.capacity : m_cursor + groups * GROUP;
+        for (; m_cursor < stop && m_old.size != 0; ++m_cursor) {
+            if (isFull(m_old.ctrl[m_cursor])) {
+                std::size_t hash = hashOf(m_old.slots[m_cursor].key);
+                std::size_t j = findFree(m_table, hash);
+                std::construct_at(m_table.slots + j, std::move(m_old.slots[m_cursor]));
+                commitInsert(m_table, j, hash);
+                eraseAt(m_old, m_cursor);
+            }
+        }
+        if (m_old.size == 0) {
+            deallocate(m_old);
+            m_cursor = 0;
+        }
+    }
+
+    void finishRehash() {
+        if (rehashing()) {
+            migrate(m_old.capacity / GROUP);
+        }
+    }
+
+    // Moves every element into a fresh table of cap slots.
+    void rebuild(std::size_t cap) {
+        Table old = std::exchange(m_table, allocate(cap));
+        for (std::size_t i = 0; i < old.capacity; ++i) {
+            if (isFull(old.ctrl[i])) {
+                std::size_t hash = hashOf(old.slots[i].key);
+                std::size_t j = findFree(m_table, hash);
+                std::construct_at(m_table.slots + j, std::move(old.slots[i]));
+                std::destroy_at(old.slots + i);
+                commitInsert(m_table, j, hash);
+            }
+        }
+        deallocate(old);
+    }
+
+    static Table allocate(std::size_t cap) {
+        auto* ctrl = static_cast<ctrl_t*>(std::calloc(cap, sizeof(ctrl_t)));
+        if (!ctrl) {
+            throw std::bad_alloc{};
+        }
+        Table table;
+        try {
+            table.slots = std::allocator<Kvp>{}.allocate(cap);
+        } catch (...) {
+            std::free(ctrl);
+            throw;
+        }
+        table.ctrl = ctrl;
+        table.capacity = cap;
+        return table;
+    }
+
+    static void deallocate(Table& table) noexcept {
+        std::free(table.ctrl);
+        if (table.slots) {
+            std::allocator<Kvp>{}.deallocate(table.slots, table.capacity);
+        }
+        table = {};
+    }
+
+    static void destroyTable(Table& table) noexcept {
+        for (std::size_t i = 0; i < table.capacity; ++i) {
+            if (isFull(table.ctrl[i])) {
+                std::destroy_at(table.slots + i);
+            }
+        }
+        deallocate(table);
+    }
+
+    // Same layout as table, tombstones included, so every probe sequence stays valid.
+    static Table copyTable(const Table& table) {
+        if (table.capacity == 0) {
+            return {};
+        }
+        Table copy = allocate(table.capacity);
+        try {
+            for (std::size_t i = 0; i < table.capacity; ++i) {
+                if (isFull(table.ctrl[i])) {
+                    std::construct_at(copy.slots + i, table.slots[i]);
+                    copy.ctrl[i] = table.ctrl[i];
+                }
             }
+        } catch (...) {
+            destroyTable(copy);
+            throw;
         }
-        m_table = std::move(new_table);
+        std::copy_n(table.ctrl, table.capacity, copy.ctrl);
+        copy.size = table.size;
+        copy.deleted = table.deleted;
+        return copy;
     }
 };
@@ -0,0 +1,25 @@
+#pragma once
+
+#if defined(__x86_64__) || defined(__i386__)
+#define DS_SIMD_X86 1
+#endif
+
+// Instruction set extensions detected at runtime. Kernels compiled with target attributes are
+// only called when the running CPU reports the matching feature.
+struct CpuFeatures {
+    bool sse42{false};
+    bool avx2{false};
+};
+
+inline const CpuFeatures& cpuFeatures() noexcept {
+    static const CpuFeatures features = [] {
+        CpuFeatures detected;
+#if defined(DS_SIMD_X86) && (defined(__GNUC__) || defined(__clang__))
+        __builtin_cpu_init();
+        detected.sse42 = __builtin_cpu_supports("sse4.2");
+        detected.avx2 = __builtin_cpu_supports("avx2");
+#endif
+        return detected;
+    }();
+    return features;
+}
@@ -0,0 +1,281 @@
+#pragma once
+
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include "cpu_features.hpp"
+
+#if defined(DS_SIMD_X86)
+#include <immintrin.h>
+#define DS_TARGET(isa) __attribute__((target(isa)))
+#endif
+
+// Element types whose operator== is plain bitwise equality. Arithmetic types other than floating
+// point, enums and pointers qualify; specialize this for padding-free PODs with a defaulted ==.
+template<typename T>
+struct BitwiseComparable
+    : std::bool_constant<std::is_scalar_v<T> && !std::is_floating_point_v<T> && !std::is_member_pointer_v<T> &&
+                         std::has_unique_object_representations_v<T>> {};
+
+// Types the SIMD search kernels handle: 1, 2, 4 or 8 byte bitwise comparable values, float and double.
+template<typename T>
+concept SimdSearchable =
+    (BitwiseComparable<T>::value && (sizeof(T) == 1 || sizeof(T) == 2 || sizeof(T) == 4 || sizeof(T) == 8)) ||
+    std::is_same_v<T, float> || std::is_same_v<T, double>;
+
+struct ScalarSearch {
+    template<typename T>
+    static std::size_t find(const T* data, std::size_t n, T value) noexcept {
+        for (std::size_t i = 0; i < n; ++i) {
+            if (data[i] == value) {
+                return i;
+            }
+        }
+        return n;
+    }
+
+    template<typename T>
+    static std::size_t count(const T* data, std::size_t n, T value) noexcept {
+        std::size_t hits = 0;
+        for (std::size_t i = 0; i < n; ++i) {
+            hits += data[i] == value;
+        }
+        return hits;
+    }
+
+    // Branch-free compaction of the elements not equal to value, starting at index from.
+    template<typename T>
+    static std::size_t remove(T* data, std::size_t from, std::size_t n, T value) noexcept {
+        return compact(data, from, from, n, value);
+    }
+
+    // Copies the elements of [src, n) that differ from value down to dst and returns the new end.
+    template<typename T>
+    static std::size_t compact(T* data, std::size_t dst, std::size_t src, std::size_t n, T value) noexcept {
+        for (; src < n; ++src) {
+            T elem = data[src];
+            data[dst] = elem;
+            dst += !(elem == value);
+        }
+        return dst;
+    }
+};
+
+#if defined(DS_SIMD_X86)
+struct Sse42Search {
+    template<typename T>
+    DS_TARGET("sse4.2")
+    static __m128i equalMask(__m128i chunk, T value) noexcept {
+        if constexpr (std::is_same_v<T, float>) {
+            return _mm_castps_si128(_mm_cmpeq_ps(_mm_castsi128_ps(chunk), _mm_set1_ps(value)));
+        } else if constexpr (std::is_same_v<T, double>) {
+            return _mm_castpd_si128(_mm_cmpeq_pd(_mm_castsi128_pd(chunk), _mm_set1_pd(value)));
+        } else if constexpr (sizeof(T) == 1) {
+            return _mm_cmpeq_epi8(chunk, _mm_set1_epi8(std::bit_cast<char>(value)));
+        } else if constexpr (sizeof(T) == 2) {
+            return _mm_cmpeq_epi16(chunk, _mm_set1_epi16(std::bit_cast<short>(value)));
+        } else if constexpr (sizeof(T) == 4) {
+            return _mm_cmpeq_epi32(chunk, _mm_set1_epi32(std::bit_cast<int>(value)));
+        } else {
+            return _mm_cmpeq_epi64(chunk, _mm_set1_epi64x(std::bit_cast<long long>(value)));
+        }
+    }
+
+    template<typename T>
+    DS_TARGET("sse4.2")
+    static unsigned matchBits(const T* data, T value) noexcept {
+        __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data));
+        return static_cast<unsigned>(_mm_movemask_epi8(equalMask(chunk, value)));
+    }
+
+    template<typename T>
+    DS_TARGET("sse4.2")
+    static std::size_t find(const T* data, std::size_t n, T value) noexcept {
+        constexpr std::size_t lanes = 16 / sizeof(T);
+        std::size_t i = 0;
+        for (; i + lanes <= n; i += lanes) {
+            if (unsigned bits = matchBits(data + i, value)) {
+                return i + static_cast<std::size_t>(std::countr_zero(bits)) / sizeof(T);
+            }
+        }
+        return i + ScalarSearch::find(data + i, n - i, value);
+    }
+
+    template<typename T>
+    DS_TARGET("sse4.2,popcnt")
+    static std::size_t count(const T* data, std::size_t n, T value) noexcept {
+        constexpr std::size_t lanes = 16 / sizeof(T);
+        std::size_t hits = 0;
+        std::size_t i = 0;
+        for (; i + lanes <= n; i += lanes) {
+            hits += static_cast<std::size_t>(std::popcount(matchBits(data + i, value)));
+        }
+        return hits / sizeof(T) + ScalarSearch::count(data + i, n - i, value);
+    }
+};
+
+struct Avx2Search {
+    template<typename T>
+    DS_TARGET("avx2")
+    static __m256i equalMask(__m256i chunk, T value) noexcept {
+        if constexpr (std::is_same_v<T, float>) {
+            return _mm256_castps_si256(_mm256_cmp_ps(_mm256_castsi256_ps(chunk), _mm256_set1_ps(value), _CMP_EQ_OQ));
+        } else if constexpr (std::is_same_v<T, double>) {
+            return _mm256_castpd_si256(_mm256_cmp_pd(_mm256_castsi256_pd(chunk), _mm256_set1_pd(value), _CMP_EQ_OQ));
+        } else if constexpr (sizeof(T) == 1) {
+            return _mm256_cmpeq_epi8(chunk, _mm256_set1_epi8(std::bit_cast<char>(value)));
+        } else if constexpr (sizeof(T) == 2) {
+            return _mm256_cmpeq_epi16(chunk, _mm256_set1_epi16(std::bit_cast<short>(value)));
+        } else if constexpr (sizeof(T) == 4) {
+            return _mm256_cmpeq_epi32(chunk, _mm256_set1_epi32(std::bit_cast<int>(value)));
+        } else {
+            return _mm256_cmpeq_epi64(chunk, _mm256_set1_epi64x(std::bit_cast<long long>(value)));
+        }
+    }
+
+    template<typename T>
+    DS_TARGET("avx2")
+    static std::uint32_t matchBits(const T* data, T value) noexcept {
+        __m256i chunk = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data));
+        return static_cast<std::uint32_t>(_mm256_movemask_epi8(equalMask(chunk, value)));
+    }
+
+    template<typename T>
+    DS_TARGET("avx2")
+    static std::size_t find(const T* data, std::size_t n, T value) noexcept {
+        constexpr std::size_t lanes = 32 / sizeof(T);
+        std::size_t i = 0;
+        // Two vectors per iteration keep both load ports busy on long scans.
+        for (; i + 2 * lanes <= n; i += 2 * lanes) {
+            std::uint64_t bits = matchBits(data + i, value) |
+                                 (static_cast<std::uint64_t>(matchBits(data + i + lanes, value)) << 32);
+            if (bits) {
+                return i + static_cast<std::size_t>(std::countr_zero(bits)) / sizeof(T);
+            }
+        }
+        return i + Sse42Search::find(data + i, n - i, value);
+    }
+
+    template<typename T>
+    DS_TARGET("avx2,popcnt")
+    static std::size_t count(const T* data, std::size_t n, T value) noexcept {
+        constexpr std::size_t lanes = 32 / sizeof(T);
+        std::size_t hits = 0;
+        std::size_t i = 0;
+        for (; i + lanes <= n; i += lanes) {
+            hits += static_cast<std::size_t>(std::popcount(matchBits(data + i, value)));
+        }
+        return hits / sizeof(T) + ScalarSearch::count(data + i, n - i, value);
+    }
+
+    // Permutation tables for vpermd: entry m moves the lanes selected by the bits of m to the front.
+    static constexpr auto compress32 = [] {
+        std::array<std::array<std::int32_t, 8>, 256> table{};
+        for (std::size_t mask = 0; mask < 256; ++mask) {
+            std::size_t out = 0;
+            for (std::int32_t lane = 0; lane < 8; ++lane) {
+                if (mask & (std::size_t{1} << lane)) {
+                    table[mask][out++] = lane;
+                }
+            }
+        }
+        return table;
+    }();
+
+    static constexpr auto compress64 = [] {
+        std::array<std::array<std::int32_t, 8>, 16> table{};
+        for (std::size_t mask = 0; mask < 16; ++mask) {
+            std::size_t out = 0;
+            for (std::int32_t lane = 0; lane < 4; ++lane) {
+                if (mask & (std::size_t{1} << lane)) {
+                    table[mask][out++] = 2 * lane;
+                    table[mask][out++] = 2 * lane + 1;
+                }
+            }
+        }
+        return table;
+    }();
+
+    // Stream compaction for 4 and 8 byte elements: each vector of survivors is permuted to the
+    // front and stored unaligned at the write cursor, which never passes the read cursor.
+    template<typename T>
+    DS_TARGET("avx2,popcnt")
+    static std::size_t remove(T* data, std::size_t from, std::size_t n, T value) noexcept {
+        if constexpr (sizeof(T) == 4 || sizeof(T) == 8) {
+            constexpr std::size_t lanes = 32 / sizeof(T);
+            std::size_t dst = from;
+            std::size_t i = from;
+            for (; i + lanes <= n; i += lanes) {
+                __m256i chunk = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i));
+                __m256i eq = equalMask(chunk, value);
+                unsigned keep;
+                const std::int32_t* perm;
+                if constexpr (sizeof(T) == 4) {
+                    keep = ~static_cast<unsigned>(_mm256_movemask_ps(_mm256_castsi256_ps(eq))) & 0xFFu;
+                    perm = compress32[keep].data();
+                } else {
+                    keep = ~static_cast<unsigned>(_mm256_movemask_pd(_mm256_castsi256_pd(eq))) & 0xFu;
+                    perm = compress64[keep].data();
+                }
+                __m256i idx = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(perm));
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(data + dst), _mm256_permutevar8x32_epi32(chunk, idx));
+                dst += static_cast<std::size_t>(std::popcount(keep));
+            }
+            return ScalarSearch::compact(data, dst, i, n, value);
+        } else {
+            return ScalarSearch::remove(data, from, n, value);
+        }
+    }
+};
+#endif
+
+// Index of the first element equal to value, or n if there is none.
+template<typename T>
+std::size_t simdFind(const T* data, std::size_t n, const T& value) noexcept {
+#if defined(DS_SIMD_X86)
+    if constexpr (SimdSearchable<T>) {
+        if (cpuFeatures().avx2) {
+            return Avx2Search::find(data, n, value);
+        }
+        if (cpuFeatures().sse42) {
+            return Sse42Search::find(data, n, value);
+        }
+    }
+#endif
+    return ScalarSearch::find(data, n, value);
+}
+
+// Number of elements equal to value.
+template<typename T>
+std::size_t simdCount(const T* data, std::size_t n, const T& value) noexcept {
+#if defined(DS_SIMD_X86)
+    if constexpr (SimdSearchable<T>) {
+        if (cpuFeatures().avx2) {
+            return Avx2Search::count(data, n, value);
+        }
+        if (cpuFeatures().sse42) {
+            return Sse42Search::count(data, n, value);
+        }
+    }
+#endif
+    return ScalarSearch::count(data, n, value);
+}
+
+// Moves the elements not equal to value to the front, keeping their order, and returns how many
+// there are. Only meant for types satisfying SimdSearchable, which are all trivially copyable.
+template<typename T>
+std::size_t simdRemove(T* data, std::size_t n, const T& value) noexcept {
+    std::size_t first = simdFind(data, n, value);
+    if (first == n) {
+        return n;
+    }
+#if defined(DS_SIMD_X86)
+    if (cpuFeatures().avx2) {
+        return Avx2Search::remove(data, first, n, value);
+    }
+#endif
+    return ScalarSearch::remove(data, first, n, value);
+}
@@ -0,0 +1,230 @@
+#pragma once
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string_view>
+#include "cpu_features.hpp"
+#include "simd_find.hpp"
+
+// Byte string search kernels. Like the simd_find kernels they return n when nothing matches.
+// Substring search uses the first/last byte filter: a vector of candidate start positions is
+// compared against the needle's first byte and, shifted by m - 1, against its last byte, and only
+// positions passing both are verified with memcmp.
+
+struct ScalarStrSearch {
+    static std::size_t rfind(const char* data, std::size_t n, char value) noexcept {
+        for (std::size_t i = n; i > 0; --i) {
+            if (data[i - 1] == value) {
+                return i - 1;
+            }
+        }
+        return n;
+    }
+
+    static std::size_t find(const char* hay, std::size_t n, const char* needle, std::size_t m) noexcept {
+        std::size_t pos = std::string_view{hay, n}.find(std::string_view{needle, m});
+        return pos == std::string_view::npos ? n : pos;
+    }
+
+    static std::size_t rfind(const char* hay, std::size_t n, const char* needle, std::size_t m) noexcept {
+        std::size_t pos = std::string_view{hay, n}.rfind(std::string_view{needle, m});
+        return pos == std::string_view::npos ? n : pos;
+    }
+};
+
+#if defined(DS_SIMD_X86)
+struct Sse42StrSearch {
+    DS_TARGET("sse4.2")
+    static unsigned candidates(const char* hay, std::size_t i, std::size_t m, __m128i first, __m128i last) noexcept {
+        __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(hay + i));
+        __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(hay + i + m - 1));
+        return static_cast<unsigned>(_mm_movemask_epi8(_mm_and_si128(_mm_cmpeq_epi8(a, first), _mm_cmpeq_epi8(b, last))));
+    }
+
+    DS_TARGET("sse4.2")
+    static std::size_t find(const char* hay, std::size_t n, const char* needle, std::size_t m) noexcept {
+        __m128i first = _mm_set1_epi8(needle[0]);
+        __m128i last = _mm_set1_epi8(needle[m - 1]);
+        std::size_t i = 0;
+        for (; i + 16 + m - 1 <= n; i += 16) {
+            for (unsigned bits = candidates(hay, i, m, first, last); bits; bits &= bits - 1) {
+                std::size_t pos = i + static_cast<std::size_t>(std::countr_zero(bits));
+                if (std::memcmp(hay + pos + 1, needle + 1, m - 2) == 0) {
+                    return pos;
+                }
+            }
+        }
+        return i + ScalarStrSearch::find(hay + i, n - i, needle, m);
+    }
+
+    DS_TARGET("sse4.2")
+    static std::size_t rfind(const char* hay, std::size_t n, const char* needle, std::size_t m) noexcept {
+        if (m > n) {
+            return n;
+        }
+        __m128i first = _mm_set1_epi8(needle[0]);
+        __m128i last = _mm_set1_epi8(needle[m - 1]);
+        // Candidate start positions are [0, end); blocks are taken from the top down.
+        std::size_t end = n - m + 1;
+        for (; end >= 16; end -= 16) {
+            std::size_t i = end - 16;
+            for (unsigned bits = candidates(hay, i, m, first, last); bits;) {
+                unsigned lane = 31u - static_cast<unsigned>(std::countl_zero(bits));
+                if (std::memcmp(hay + i + lane + 1, needle + 1, m - 2) == 0) {
+                    return i + lane;
+                }
+                bits &= ~(1u << lane);
+            }
+        }
+        std::size_t pos = ScalarStrSearch::rfind(hay, end + m - 1, needle, m);
+        return pos == end + m - 1 ? n : pos;
+    }
+
+    DS_TARGET("sse4.2")
+    static std::size_t rfind(const char* data, std::size_t n, char value) noexcept {
+        __m128i needle = _mm_set1_epi8(value);
+        std::size_t end = n;
+        for (; end >= 16; end -= 16) {
+            __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + end - 16));
+            if (unsigned bits = static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi8(chunk, needle)))) {
+                return end - 16 + (31u - static_cast<unsigned>(std::countl_zero(bits)));
+            }
+        }
+        std::size_t pos = ScalarStrSearch::rfind(data, end, value);
+        return pos == end ? n : pos;
+    }
+};
+
+struct Avx2StrSearch {
+    DS_TARGET("avx2")
+    static std::uint32_t candidates(const char* hay, std::size_t i, std::size_t m, __m256i first,
+                                    __m256i last) noexcept {
+        __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(hay + i));
+        __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(hay + i + m - 1));
+        return static_cast<std::uint32_t>(
+            _mm256_movemask_epi8(_mm256_and_si256(_mm256_cmpeq_epi8(a, first), _mm256_cmpeq_epi8(b, last))));
+    }
+
+    DS_TARGET("avx2")
+    static std::size_t find(const char* hay, std::size_t n, const char* needle, std::size_t m) noexcept {
+        __m256i first = _mm256_set1_epi8(needle[0]);
+        __m256i last = _mm256_set1_epi8(needle[m - 1]);
+        std::size_t i = 0;
+        for (; i + 32 + m - 1 <= n; i += 32) {
+            for (std::uint32_t bits = candidates(hay, i, m, first, last); bits; bits &= bits - 1) {
+                std::size_t pos = i + static_cast<std::size_t>(std::countr_zero(bits));
+                if (std::memcmp(hay + pos + 1, needle + 1, m - 2) == 0) {
+                    return pos;
+                }
+            }
+        }
+        // Finish with one block that overlaps the last one, masking out the positions already checked.
+        std::size_t end = n - m + 1;
+        if (i > 0 && i < end) {
+            std::size_t start = end - 32;
+            std::uint32_t bits = candidates(hay, start, m, first, last) & (~std::uint32_t{0} << (i - start));
+            for (; bits; bits &= bits - 1) {
+                std::size_t pos = start + static_cast<std::size_t>(std::countr_zero(bits));
+                if (std::memcmp(hay + pos + 1, needle + 1, m - 2) == 0) {
+                    return pos;
+                }
+            }
+            return n;
+        }
+        return i + Sse42StrSearch::find(hay + i, n - i, needle, m);
+    }
+
+    DS_TARGET("avx2")
+    static std::size_t rfind(const char* hay, std::size_t n, const char* needle, std::size_t m) noexcept {
+        __m256i first = _mm256_set1_epi8(needle[0]);
+        __m256i last = _mm256_set1_epi8(needle[m - 1]);
+        std::size_t end = n - m + 1;
+        for (; end >= 32; end -= 32) {
+            std::size_t i = end - 32;
+            for (std::uint32_t bits = candidates(hay, i, m, first, last); bits;) {
+                unsigned lane = 31u - static_cast<unsigned>(std::countl_zero(bits));
+                if (std::memcmp(hay + i + lane + 1, needle + 1, m - 2) == 0) {
+                    return i + lane;
+                }
+                bits &= ~(std::uint32_t{1} << lane);
+            }
+        }
+        std::size_t pos = Sse42StrSearch::rfind(hay, end + m - 1, needle, m);
+        return pos == end + m - 1 ? n : pos;
+    }
+
+    DS_TARGET("avx2")
+    static std::size_t rfind(const char* data, std::size_t n, char value) noexcept {
+        __m256i needle = _mm256_set1_epi8(value);
+        std::size_t end = n;
+        for (; end >= 32; end -= 32) {
+            __m256i chunk = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + end - 32));
+            auto bits = static_cast<std::uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(chunk, needle)));
+            if (bits) {
+                return end - 32 + (31u - static_cast<unsigned>(std::countl_zero(bits)));
+            }
+        }
+        std::size_t pos = Sse42StrSearch::rfind(data, end, value);
+        return pos == end ? n : pos;
+    }
+};
+#endif
+
+// Index of the last byte equal to value, or n if there is none.
+inline std::size_t simdRFind(const char* data, std::size_t n, char value) noexcept {
+#if defined(DS_SIMD_X86)
+    if (cpuFeatures().avx2) {
+        return Avx2StrSearch::rfind(data, n, value);
+    }
+    if (cpuFeatures().sse42) {
+        return Sse42StrSearch::rfind(data, n, value);
+    }
+#endif
+    return ScalarStrSearch::rfind(data, n, value);
+}
+
+// Index of the first occurrence of needle[0, m) in hay[0, n), or n if there is none.
+inline std::size_t simdFind(const char* hay, std::size_t n, const char* needle, std::size_t m) noexcept {
+    if (m == 0) {
+        return 0;
+    }
+    if (m > n) {
+        return n;
+    }
+    if (m == 1) {
+        return simdFind(hay, n, needle[0]);
+    }
+#if defined(DS_SIMD_X86)
+    if (cpuFeatures().avx2) {
+        return Avx2StrSearch::find(hay, n, needle, m);
+    }
+    if (cpuFeatures().sse42) {
+        return Sse42StrSearch::find(hay, n, needle, m);
+    }
+#endif
+    return ScalarStrSearch::find(hay, n, needle, m);
+}
+
+// Index of the last occurrence of needle[0, m) in hay[0, n), or n if there is none.
+inline std::size_t simdRFind(const char* hay, std::size_t n, const char* needle, std::size_t m) noexcept {
+    if (m == 0) {
+        return n;
+    }
+    if (m > n) {
+        return n;
+    }
+    if (m == 1) {
+        return simdRFind(hay, n, needle[0]);
+    }
+#if defined(DS_SIMD_X86)
+    if (cpuFeatures().avx2) {
+        return Avx2StrSearch::rfind(hay, n, needle, m);
+    }
+    if (cpuFeatures().sse42) {
+        return Sse42StrSearch::rfind(hay, n, needle, m);
+    }
+#endif
+    return ScalarStrSearch::rfind(hay, n, needle, m);
+}
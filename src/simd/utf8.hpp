@@ -0,0 +1,409 @@
+#pragma once
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include "cpu_features.hpp"
+#include "simd_find.hpp"
+
+// UTF-8 kernels: validation, code point counting and ASCII case-insensitive comparison.
+//
+// The vector validators follow Keiser and Lemire's lookup algorithm (as in simdutf): three 16-entry
+// tables indexed by the high nibble of the previous byte, its low nibble and the high nibble of the
+// current byte each map to a set of error classes, and a pair of bytes is malformed when all three
+// agree on one. A separate check requires the second and third bytes after a 3 or 4 byte lead to
+// be continuations. Blocks that are pure ASCII skip all of that.
+
+struct ScalarUtf8 {
+    // Byte-at-a-time decoder check: rejects overlong forms, surrogates, code points above U+10FFFF
+    // and truncated sequences.
+    static bool validate(const char* data, std::size_t n) noexcept {
+        const auto* p = reinterpret_cast<const unsigned char*>(data);
+        std::size_t i = 0;
+        while (i < n) {
+            unsigned char c = p[i];
+            if (c < 0x80) {
+                ++i;
+                continue;
+            }
+            std::size_t len;
+            unsigned char lo = 0x80;
+            unsigned char hi = 0xBF;
+            if (c >= 0xC2 && c <= 0xDF) {
+                len = 2;
+            } else if (c >= 0xE0 && c <= 0xEF) {
+                len = 3;
+                lo = c == 0xE0 ? 0xA0 : 0x80;
+                hi = c == 0xED ? 0x9F : 0xBF;
+            } else if (c >= 0xF0 && c <= 0xF4) {
+                len = 4;
+                lo = c == 0xF0 ? 0x90 : 0x80;
+                hi = c == 0xF4 ? 0x8F : 0xBF;
+            } else {
+                return false;
+            }
+            if (n - i < len || p[i + 1] < lo || p[i + 1] > hi) {
+                return false;
+            }
+            for (std::size_t k = 2; k < len; ++k) {
+                if ((p[i + k] & 0xC0) != 0x80) {
+                    return false;
+                }
+            }
+            i += len;
+        }
+        return true;
+    }
+
+    // Number of bytes that are not continuation bytes, which is the code point count of valid UTF-8.
+    static std::size_t count(const char* data, std::size_t n) noexcept {
+        std::size_t total = 0;
+        for (std::size_t i = 0; i < n; ++i) {
+            total += (static_cast<unsigned char>(data[i]) & 0xC0) != 0x80;
+        }
+        return total;
+    }
+
+    static unsigned char fold(unsigned char c) noexcept {
+        return c >= 'A' && c <= 'Z' ? static_cast<unsigned char>(c | 0x20) : c;
+    }
+
+    // Whether a[0, n) and b[0, n) are equal once ASCII letters are lowercased.
+    static bool equalsIgnoreCase(const char* a, const char* b, std::size_t n) noexcept {
+        for (std::size_t i = 0; i < n; ++i) {
+            if (fold(static_cast<unsigned char>(a[i])) != fold(static_cast<unsigned char>(b[i]))) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    // Writes src[0, n) to dst with ASCII letters lowercased.
+    static void foldCase(const char* src, char* dst, std::size_t n) noexcept {
+        for (std::size_t i = 0; i < n; ++i) {
+            dst[i] = static_cast<char>(fold(static_cast<unsigned char>(src[i])));
+        }
+    }
+};
+
+namespace utf8_tables {
+    // Error classes for a pair of bytes (previous, current).
+    inline constexpr std::uint8_t TOO_SHORT = 1 << 0;  // lead byte followed by a lead or ASCII byte
+    inline constexpr std::uint8_t TOO_LONG = 1 << 1;   // ASCII followed by a continuation
+    inline constexpr std::uint8_t OVERLONG_3 = 1 << 2; // E0 80..9F
+    inline constexpr std::uint8_t TOO_LARGE = 1 << 3;  // F4 90..BF, F5..FF
+    inline constexpr std::uint8_t SURROGATE = 1 << 4;  // ED A0..BF
+    inline constexpr std::uint8_t OVERLONG_2 = 1 << 5; // C0, C1
+    inline constexpr std::uint8_t TOO_LARGE_1000 = 1 << 6;
+    inline constexpr std::uint8_t OVERLONG_4 = 1 << 6; // F0 80..8F
+    inline constexpr std::uint8_t TWO_CONTS = 1 << 7;  // two continuations; fine only after a 3 or 4 byte lead
+    inline constexpr std::uint8_t CARRY = TOO_SHORT | TOO_LONG | TWO_CONTS;
+
+    inline constexpr std::uint8_t BYTE_1_HIGH[16] = {
+        TOO_LONG, TOO_LONG, TOO_LONG, TOO_LONG, TOO_LONG, TOO_LONG, TOO_LONG, TOO_LONG,
+        TWO_CONTS, TWO_CONTS, TWO_CONTS, TWO_CONTS,
+        TOO_SHORT | OVERLONG_2,
+        TOO_SHORT,
+        TOO_SHORT | OVERLONG_3 | SURROGATE,
+        TOO_SHORT | TOO_LARGE | TOO_LARGE_1000 | OVERLONG_4,
+    };
+
+    inline constexpr std::uint8_t BYTE_1_LOW[16] = {
+        CARRY | OVERLONG_3 | OVERLONG_2 | OVERLONG_4,
+        CARRY | OVERLONG_2,
+        CARRY,
+        CARRY,
+        CARRY | TOO_LARGE,
+        CARRY | TOO_LARGE | TOO_LARGE_1000,
+        CARRY | TOO_LARGE | TOO_LARGE_1000,
+        CARRY | TOO_LARGE | TOO_LARGE_1000,
+        CARRY | TOO_LARGE | TOO_LARGE_1000,
+        CARRY | TOO_LARGE | TOO_LARGE_1000,
+        CARRY | TOO_LARGE | TOO_LARGE_1000,
+        CARRY | TOO_LARGE | TOO_LARGE_1000,
+        CARRY | TOO_LARGE | TOO_LARGE_1000,
+        CARRY | TOO_LARGE | TOO_LARGE_1000 | SURROGATE,
+        CARRY | TOO_LARGE | TOO_LARGE_1000,
+        CARRY | TOO_LARGE | TOO_LARGE_1000,
+    };
+
+    inline constexpr std::uint8_t BYTE_2_HIGH[16] = {
+        TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT,
+        TOO_LONG | OVERLONG_2 | TWO_CONTS | OVERLONG_3 | TOO_LARGE_1000 | OVERLONG_4,
+        TOO_LONG | OVERLONG_2 | TWO_CONTS | OVERLONG_3 | TOO_LARGE,
+        TOO_LONG | OVERLONG_2 | TWO_CONTS | SURROGATE | TOO_LARGE,
+        TOO_LONG | OVERLONG_2 | TWO_CONTS | SURROGATE | TOO_LARGE,
+        TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT,
+    };
+
+    // Largest byte allowed in each of the last three positions of the input: a 2, 3 or 4 byte lead
+    // there would need bytes that do not exist. Indexed from the end of a 32-byte block.
+    inline constexpr std::uint8_t INCOMPLETE_MAX[32] = {
+        0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+        0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xF0 - 1, 0xE0 - 1, 0xC0 - 1,
+    };
+} // namespace utf8_tables
+
+#if defined(DS_SIMD_X86)
+struct Sse42Utf8 {
+    struct State {
+        __m128i prev;
+        __m128i error;
+        __m128i incomplete;
+    };
+
+    DS_TARGET("sse4.2")
+    static __m128i lookup(const std::uint8_t (&table)[16], __m128i idx) noexcept {
+        return _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(table)), idx);
+    }
+
+    DS_TARGET("sse4.2")
+    static void check(State& s, __m128i input) noexcept {
+        using namespace utf8_tables;
+        if (_mm_movemask_epi8(input) == 0) {
+            // ASCII: only a sequence left open by the previous block can be wrong.
+            s.error = _mm_or_si128(s.error, s.incomplete);
+            s.prev = input;
+            s.incomplete = _mm_setzero_si128();
+            return;
+        }
+        __m128i nibble = _mm_set1_epi8(0x0F);
+        __m128i prev1 = _mm_alignr_epi8(input, s.prev, 15);
+        __m128i sc = _mm_and_si128(
+            _mm_and_si128(lookup(BYTE_1_HIGH, _mm_and_si128(_mm_srli_epi16(prev1, 4), nibble)),
+                          lookup(BYTE_1_LOW, _mm_and_si128(prev1, nibble))),
+            lookup(BYTE_2_HIGH, _mm_and_si128(_mm_srli_epi16(input, 4), nibble)));
+        __m128i prev2 = _mm_alignr_epi8(input, s.prev, 14);
+        __m128i prev3 = _mm_alignr_epi8(input, s.prev, 13);
+        __m128i must23 = _mm_or_si128(_mm_subs_epu8(prev2, _mm_set1_epi8(static_cast<char>(0xE0 - 0x80))),
+                                      _mm_subs_epu8(prev3, _mm_set1_epi8(static_cast<char>(0xF0 - 0x80))));
+        __m128i must23_80 = _mm_and_si128(must23, _mm_set1_epi8(static_cast<char>(0x80)));
+        s.error = _mm_or_si128(s.error, _mm_xor_si128(must23_80, sc));
+        s.incomplete =
+            _mm_subs_epu8(input, _mm_loadu_si128(reinterpret_cast<const __m128i*>(INCOMPLETE_MAX + 16)));
+        s.prev = input;
+    }
+
+    DS_TARGET("sse4.2")
+    static bool validate(const char* data, std::size_t n) noexcept {
+        State s{_mm_setzero_si128(), _mm_setzero_si128(), _mm_setzero_si128()};
+        std::size_t i = 0;
+        for (; i + 16 <= n; i += 16) {
+            check(s, _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i)));
+        }
+        if (i < n) {
+            // Zero padding is ASCII, so it closes nothing and opens nothing.
+            alignas(16) char tail[16] = {};
+            std::memcpy(tail, data + i, n - i);
+            check(s, _mm_load_si128(reinterpret_cast<const __m128i*>(tail)));
+        }
+        s.error = _mm_or_si128(s.error, s.incomplete);
+        return _mm_testz_si128(s.error, s.error);
+    }
+
+    DS_TARGET("sse4.2,popcnt")
+    static std::size_t count(const char* data, std::size_t n) noexcept {
+        // Continuation bytes are 0x80..0xBF, the only bytes <= -65 as signed chars.
+        __m128i limit = _mm_set1_epi8(-65);
+        std::size_t total = 0;
+        std::size_t i = 0;
+        for (; i + 16 <= n; i += 16) {
+            __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+            total += static_cast<std::size_t>(std::popcount(static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpgt_epi8(v, limit)))));
+        }
+        return total + ScalarUtf8::count(data + i, n - i);
+    }
+
+    DS_TARGET("sse4.2")
+    static __m128i fold(__m128i v) noexcept {
+        __m128i upper = _mm_and_si128(_mm_cmpgt_epi8(v, _mm_set1_epi8('A' - 1)), _mm_cmplt_epi8(v, _mm_set1_epi8('Z' + 1)));
+        return _mm_or_si128(v, _mm_and_si128(upper, _mm_set1_epi8(0x20)));
+    }
+
+    DS_TARGET("sse4.2")
+    static bool equalsIgnoreCase(const char* a, const char* b, std::size_t n) noexcept {
+        std::size_t i = 0;
+        for (; i + 16 <= n; i += 16) {
+            __m128i va = fold(_mm_loadu_si128(reinterpret_cast<const __m128i*>(a + i)));
+            __m128i vb = fold(_mm_loadu_si128(reinterpret_cast<const __m128i*>(b + i)));
+            if (_mm_movemask_epi8(_mm_cmpeq_epi8(va, vb)) != 0xFFFF) {
+                return false;
+            }
+        }
+        return ScalarUtf8::equalsIgnoreCase(a + i, b + i, n - i);
+    }
+
+    DS_TARGET("sse4.2")
+    static void foldCase(const char* src, char* dst, std::size_t n) noexcept {
+        std::size_t i = 0;
+        for (; i + 16 <= n; i += 16) {
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i),
+                             fold(_mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i))));
+        }
+        ScalarUtf8::foldCase(src + i, dst + i, n - i);
+    }
+};
+
+struct Avx2Utf8 {
+    struct State {
+        __m256i prev;
+        __m256i error;
+        __m256i incomplete;
+    };
+
+    DS_TARGET("avx2")
+    static __m256i lookup(const std::uint8_t (&table)[16], __m256i idx) noexcept {
+        return _mm256_shuffle_epi8(
+            _mm256_broadcastsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i*>(table))), idx);
+    }
+
+    // The input shifted right by n bytes across the whole register, pulling in the end of prev.
+    template<int N>
+    DS_TARGET("avx2")
+    static __m256i prevBytes(__m256i input, __m256i prev) noexcept {
+        return _mm256_alignr_epi8(input, _mm256_permute2x128_si256(prev, input, 0x21), 16 - N);
+    }
+
+    DS_TARGET("avx2")
+    static void check(State& s, __m256i input) noexcept {
+        using namespace utf8_tables;
+        if (_mm256_movemask_epi8(input) == 0) {
+            // ASCII: only a sequence left open by the previous block can be wrong.
+            s.error = _mm256_or_si256(s.error, s.incomplete);
+            s.prev = input;
+            s.incomplete = _mm256_setzero_si256();
+            return;
+        }
+        __m256i nibble = _mm256_set1_epi8(0x0F);
+        __m256i prev1 = prevBytes<1>(input, s.prev);
+        __m256i sc = _mm256_and_si256(
+            _mm256_and_si256(lookup(BYTE_1_HIGH, _mm256_and_si256(_mm256_srli_epi16(prev1, 4), nibble)),
+                             lookup(BYTE_1_LOW, _mm256_and_si256(prev1, nibble))),
+            lookup(BYTE_2_HIGH, _mm256_and_si256(_mm256_srli_epi16(input, 4), nibble)));
+        __m256i prev2 = prevBytes<2>(input, s.prev);
+        __m256i prev3 = prevBytes<3>(input, s.prev);
+        __m256i must23 =
+            _mm256_or_si256(_mm256_subs_epu8(prev2, _mm256_set1_epi8(static_cast<char>(0xE0 - 0x80))),
+                            _mm256_subs_epu8(prev3, _mm256_set1_epi8(static_cast<char>(0xF0 - 0x80))));
+        __m256i must23_80 = _mm256_and_si256(must23, _mm256_set1_epi8(static_cast<char>(0x80)));
+        s.error = _mm256_or_si256(s.error, _mm256_xor_si256(must23_80, sc));
+        s.incomplete = _mm256_subs_epu8(input, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(INCOMPLETE_MAX)));
+        s.prev = input;
+    }
+
+    DS_TARGET("avx2")
+    static bool validate(const char* data, std::size_t n) noexcept {
+        State s{_mm256_setzero_si256(), _mm256_setzero_si256(), _mm256_setzero_si256()};
+        std::size_t i = 0;
+        for (; i + 32 <= n; i += 32) {
+            check(s, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i)));
+        }
+        if (i < n) {
+            // Zero padding is ASCII, so it closes nothing and opens nothing.
+            alignas(32) char tail[32] = {};
+            std::memcpy(tail, data + i, n - i);
+            check(s, _mm256_load_si256(reinterpret_cast<const __m256i*>(tail)));
+        }
+        s.error = _mm256_or_si256(s.error, s.incomplete);
+        return _mm256_testz_si256(s.error, s.error);
+    }
+
+    DS_TARGET("avx2,popcnt")
+    static std::size_t count(const char* data, std::size_t n) noexcept {
+        // Continuation bytes are 0x80..0xBF, the only bytes <= -65 as signed chars.
+        __m256i limit = _mm256_set1_epi8(-65);
+        std::size_t total = 0;
+        std::size_t i = 0;
+        for (; i + 32 <= n; i += 32) {
+            __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i));
+            total += static_cast<std::size_t>(
+                std::popcount(static_cast<std::uint32_t>(_mm256_movemask_epi8(_mm256_cmpgt_epi8(v, limit)))));
+        }
+        return total + ScalarUtf8::count(data + i, n - i);
+    }
+
+    DS_TARGET("avx2")
+    static __m256i fold(__m256i v) noexcept {
+        __m256i upper = _mm256_and_si256(_mm256_cmpgt_epi8(v, _mm256_set1_epi8('A' - 1)),
+                                         _mm256_cmpgt_epi8(_mm256_set1_epi8('Z' + 1), v));
+        return _mm256_or_si256(v, _mm256_and_si256(upper, _mm256_set1_epi8(0x20)));
+    }
+
+    DS_TARGET("avx2")
+    static bool equalsIgnoreCase(const char* a, const char* b, std::size_t n) noexcept {
+        std::size_t i = 0;
+        for (; i + 32 <= n; i += 32) {
+            __m256i va = fold(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i)));
+            __m256i vb = fold(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + i)));
+            if (static_cast<std::uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(va, vb))) != 0xFFFFFFFFu) {
+                return false;
+            }
+        }
+        return ScalarUtf8::equalsIgnoreCase(a + i, b + i, n - i);
+    }
+
+    DS_TARGET("avx2")
+    static void foldCase(const char* src, char* dst, std::size_t n) noexcept {
+        std::size_t i = 0;
+        for (; i + 32 <= n; i += 32) {
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i),
+                                fold(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i))));
+        }
+        ScalarUtf8::foldCase(src + i, dst + i, n - i);
+    }
+};
+#endif
+
+// Whether data[0, n) is well-formed UTF-8.
+inline bool simdValidateUtf8(const char* data, std::size_t n) noexcept {
+#if defined(DS_SIMD_X86)
+    if (cpuFeatures().avx2) {
+        return Avx2Utf8::validate(data, n);
+    }
+    if (cpuFeatures().sse42) {
+        return Sse42Utf8::validate(data, n);
+    }
+#endif
+    return ScalarUtf8::validate(data, n);
+}
+
+// Number of code points in data[0, n), assuming it is valid UTF-8.
+inline std::size_t simdCountUtf8(const char* data, std::size_t n) noexcept {
+#if defined(DS_SIMD_X86)
+    if (cpuFeatures().avx2) {
+        return Avx2Utf8::count(data, n);
+    }
+    if (cpuFeatures().sse42) {
+        return Sse42Utf8::count(data, n);
+    }
+#endif
+    return ScalarUtf8::count(data, n);
+}
+
+// Whether a[0, n) and b[0, n) are equal ignoring the case of ASCII letters. Other bytes, including
+// all of multibyte UTF-8, must match exactly.
+inline bool simdEqualsIgnoreCase(const char* a, const char* b, std::size_t n) noexcept {
+#if defined(DS_SIMD_X86)
+    if (cpuFeatures().avx2) {
+        return Avx2Utf8::equalsIgnoreCase(a, b, n);
+    }
+    if (cpuFeatures().sse42) {
+        return Sse42Utf8::equalsIgnoreCase(a, b, n);
+    }
+#endif
+    return ScalarUtf8::equalsIgnoreCase(a, b, n);
+}
+
+// Copies src[0, n) to dst with ASCII letters lowercased.
+inline void simdFoldCase(const char* src, char* dst, std::size_t n) noexcept {
+#if defined(DS_SIMD_X86)
+    if (cpuFeatures().avx2) {
+        return Avx2Utf8::foldCase(src, dst, n);
+    }
+    if (cpuFeatures().sse42) {
+        return Sse42Utf8::foldCase(src, dst, n);
+    }
+#endif
+    ScalarUtf8::foldCase(src, dst, n);
+}
@@ -0,0 +1,328 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <memory>
+#include <ranges>
+#include <stdexcept>
+#include <string_view>
+#include <utility>
+#include <vector>
+#include "my_string.hpp"
+
+// An immutable string stored as an AVL-balanced binary tree whose leaves are slices of shared
+// String chunks. Concatenation, substr and indexing take O(log n) and never copy large chunks:
+// substr slices leaves, and concatenation only links trees. Small leaves meeting at a
+// concatenation boundary are merged so that ropes built from tiny fragments stay shallow.
+class Rope {
+    struct Node;
+    using NodePtr = std::shared_ptr<const Node>;
+
+    struct Node {
+        std::size_t length{0};
+        std::uint8_t height{0};
+        // Leaf: the slice [offset, offset + length) of chunk.
+        std::shared_ptr<const String> chunk;
+        std::size_t offset{0};
+        // Concatenation: left followed by right.
+        NodePtr left;
+        NodePtr right;
+
+        [[nodiscard]] bool is_leaf() const noexcept { return height == 0; }
+        [[nodiscard]] std::string_view view() const noexcept { return {chunk->data() + offset, length}; }
+    };
+
+public:
+    // Leaves up to this many bytes are merged by copying instead of linked.
+    static constexpr std::size_t MERGE_LEN{512};
+    // Size of the chunks a Builder packs small fragments into.
+    static constexpr std::size_t CHUNK_LEN{16 * 1024};
+
+    class Builder;
+
+    class ChunkIterator {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = std::string_view;
+        using difference_type = std::ptrdiff_t;
+
+        ChunkIterator() = default;
+
+        std::string_view operator*() const noexcept { return m_stack.back().node->view(); }
+
+        ChunkIterator& operator++() {
+            m_stack.pop_back();
+            while (!m_stack.empty() && m_stack.back().inRight) {
+                m_stack.pop_back();
+            }
+            if (!m_stack.empty()) {
+                m_stack.back().inRight = true;
+                descend(m_stack.back().node->right.get());
+            }
+            return *this;
+        }
+
+        ChunkIterator operator++(int) {
+            ChunkIterator tmp{*this};
+            ++*this;
+            return tmp;
+        }
+
+        // The same leaf can sit at several positions of a rope, so positions compare by whole path.
+        friend bool operator==(const ChunkIterator& a, const ChunkIterator& b) noexcept {
+            return a.m_stack == b.m_stack;
+        }
+        friend bool operator==(const ChunkIterator& it, std::default_sentinel_t) noexcept { return it.m_stack.empty(); }
+
+    private:
+        friend class Rope;
+
+        explicit ChunkIterator(const Node* root) {
+            if (root) {
+                descend(root);
+            }
+        }
+
+        // One step of the path from the root to the current leaf. Subtrees are shared (a + a has the
+        // same node on both sides), so the branch taken is recorded rather than inferred by
+        // comparing pointers.
+        struct Frame {
+            const Node* node;
+            bool inRight;
+
+            bool operator==(const Frame&) const = default;
+        };
+
+        std::vector<Frame> m_stack;
+
+        void descend(const Node* node) {
+            m_stack.push_back({node, false});
+            while (!node->is_leaf()) {
+                node = node->left.get();
+                m_stack.push_back({node, false});
+            }
+        }
+    };
+
+    Rope() noexcept = default;
+
+    Rope(String str) {
+        if (str.size() > 0) {
+            std::size_t length = str.size();
+            m_root = make_leaf(std::make_shared<const String>(std::move(str)), 0, length);
+        }
+    }
+
+    Rope(std::string_view view) : Rope(String{view}) {}
+
+    Rope(const char* str) : Rope(String{str}) {}
+
+    friend Rope operator+(const Rope& lhs, const Rope& rhs) { return Rope{join(lhs.m_root, rhs.m_root)}; }
+
+    Rope& operator+=(const Rope& other) {
+        m_root = join(m_root, other.m_root);
+        return *this;
+    }
+
+    [[nodiscard]] std::size_t size() const noexcept { return m_root ? m_root->length : 0; }
+    [[nodiscard]] bool empty() const noexcept { return !m_root; }
+    [[nodiscard]] std::size_t height() const noexcept { return m_root ? m_root->height : 0; }
+
+    [[nodiscard]] char operator[](std::size_t idx) const noexcept {
+        const Node* node = m_root.get();
+        while (!node->is_leaf()) {
+            if (idx < node->left->length) {
+                node = node->left.get();
+            } else {
+                idx -= node->left->length;
+                node = node->right.get();
+            }
+        }
+        return node->chunk->data()[node->offset + idx];
+    }
+
+    [[nodiscard]] char at(std::size_t idx) const {
+        if (idx >= size())
+            throw std::out_of_range{"Index out of range"};
+        return (*this)[idx];
+    }
+
+    // Returns the characters [pos, pos + count), clamped to the end of the rope. Shares every leaf
+    // with *this; only the two boundary leaves are re-sliced.
+    [[nodiscard]] Rope substr(std::size_t pos, std::size_t count = std::string_view::npos) const {
+        if (pos > size())
+            throw std::out_of_range{"Rope::substr position out of range"};
+        count = std::min(count, size() - pos);
+        NodePtr tail = split(m_root, pos).second;
+        return Rope{split(tail, count).first};
+    }
+
+    // The leaves in order, as string_views into the shared chunks. Suitable for building iovecs.
+    [[nodiscard]] auto chunks() const {
+        return std::ranges::subrange{ChunkIterator{m_root.get()}, std::default_sentinel};
+    }
+
+    [[nodiscard]] String flatten() const {
+        String result;
+        result.reserve(size());
+        for (std::string_view chunk: chunks()) {
+            result.append(chunk);
+        }
+        return result;
+    }
+
+private:
+    NodePtr m_root;
+
+    friend class Builder;
+
+    explicit Rope(NodePtr root) noexcept : m_root{std::move(root)} {}
+
+    static std::size_t height_of(const NodePtr& node) noexcept { return node ? node->height : 0; }
+
+    static NodePtr make_leaf(std::shared_ptr<const String> chunk, std::size_t offset, std::size_t length) {
+        auto node = std::make_shared<Node>();
+        node->length = length;
+        node->chunk = std::move(chunk);
+        node->offset = offset;
+        return node;
+    }
+
+    static NodePtr make_concat(NodePtr left, NodePtr right) {
+        if (left->is_leaf() && right->is_leaf() && left->length + right->length <= MERGE_LEN) {
+            String merged;
+            merged.reserve(left->length + right->length);
+            merged.append(left->view());
+            merged.append(right->view());
+            return Rope{std::move(merged)}.m_root;
+        }
+        auto node = std::make_shared<Node>();
+        node->length = left->length + right->length;
+        node->height = static_cast<std::uint8_t>(std::max(left->height, right->height) + 1);
+        node->left = std::move(left);
+        node->right = std::move(right);
+        return node;
+    }
+
+    // Concatenates two balanced trees whose heights differ by at most two, rotating once if needed.
+    static NodePtr balance(NodePtr left, NodePtr right) {
+        if (height_of(left) > height_of(right) + 1) {
+            if (height_of(left->left) >= height_of(left->right)) {
+                return make_concat(left->left, make_concat(left->right, std::move(right)));
+            }
+            const NodePtr& mid = left->right;
+            return make_concat(make_concat(left->left, mid->left), make_concat(mid->right, std::move(right)));
+        }
+        if (height_of(right) > height_of(left) + 1) {
+            if (height_of(right->right) >= height_of(right->left)) {
+                return make_concat(make_concat(std::move(left), right->left), right->right);
+            }
+            const NodePtr& mid = right->left;
+            return make_concat(make_concat(std::move(left), mid->left), make_concat(mid->right, right->right));
+        }
+        return make_concat(std::move(left), std::move(right));
+    }
+
+    // AVL join: walks down the spine of the taller tree to a subtree of matching height, so the
+    // cost is proportional to the height difference.
+    static NodePtr join(NodePtr left, NodePtr right) {
+        if (!left) {
+            return right;
+        }
+        if (!right) {
+            return left;
+        }
+        if (left->height > right->height + 1) {
+            return balance(left->left, join(left->right, std::move(right)));
+        }
+        if (right->height > left->height + 1) {
+            return balance(join(std::move(left), right->left), right->right);
+        }
+        return balance(std::move(left), std::move(right));
+    }
+
+    // Splits node into its first pos characters and the rest.
+    static std::pair<NodePtr, NodePtr> split(const NodePtr& node, std::size_t pos) {
+        if (!node || pos == 0) {
+            return {nullptr, node};
+        }
+        if (pos >= node->length) {
+            return {node, nullptr};
+        }
+        if (node->is_leaf()) {
+            return {make_leaf(node->chunk, node->offset, pos),
+                    make_leaf(node->chunk, node->offset + pos, node->length - pos)};
+        }
+        std::size_t left_len = node->left->length;
+        if (pos <= left_len) {
+            auto [a, b] = split(node->left, pos);
+            return {std::move(a), join(std::move(b), node->right)};
+        }
+        auto [a, b] = split(node->right, pos - left_len);
+        return {join(node->left, std::move(a)), std::move(b)};
+    }
+
+    // Builds a balanced tree over subtrees in O(count) joins.
+    static NodePtr build_balanced(const std::vector<NodePtr>& parts, std::size_t lo, std::size_t hi) {
+        if (hi - lo == 1) {
+            return parts[lo];
+        }
+        std::size_t mid = lo + (hi - lo) / 2;
+        return join(build_balanced(parts, lo, mid), build_balanced(parts, mid, hi));
+    }
+
+public:
+    // Assembles a rope from many fragments. Small fragments are copied into CHUNK_LEN chunks and
+    // whole ropes are linked in; the tree is built once, balanced, by build(). This avoids the
+    // O(log n) path copy that each Rope::operator+= pays.
+    class Builder {
+    public:
+        Builder& append(std::string_view view) {
+            if (view.empty()) {
+                return *this;
+            }
+            if (view.size() >= CHUNK_LEN) {
+                seal();
+                m_parts.push_back(Rope{view}.m_root);
+                return *this;
+            }
+            if (m_chunk.size() + view.size() > CHUNK_LEN) {
+                seal();
+            }
+            if (m_chunk.capacity() < CHUNK_LEN) {
+                m_chunk.reserve(CHUNK_LEN);
+            }
+            m_chunk.append(view);
+            return *this;
+        }
+
+        Builder& append(const Rope& rope) {
+            if (!rope.empty()) {
+                seal();
+                m_parts.push_back(rope.m_root);
+            }
+            return *this;
+        }
+
+        [[nodiscard]] Rope build() && {
+            seal();
+            if (m_parts.empty()) {
+                return Rope{};
+            }
+            return Rope{build_balanced(m_parts, 0, m_parts.size())};
+        }
+
+    private:
+        std::vector<NodePtr> m_parts;
+        String m_chunk;
+
+        void seal() {
+            if (m_chunk.size() > 0) {
+                m_parts.push_back(Rope{std::move(m_chunk)}.m_root);
+                m_chunk = String{};
+            }
+        }
+    };
+};
@@ -1,68 +1,47 @@
 #pragma once
 
 #include <algorithm>
+#include <bit>
 #include <cstddef>
 #include <cstring>
+#include <functional>
 #include <ostream>
+#include <stdexcept>
 #include <string_view>
+#include <utility>
+#include "../simd/str_search.hpp"
+#include "../simd/utf8.hpp"
+#include "str_hash.hpp"
+#include "str_split.hpp"
+#include "utf8_view.hpp"
 
+// A 24-byte string that keeps up to 23 characters inline. The last byte of the object holds
+// SSO_LEN - size for inline strings, so it doubles as the terminator of a full 23-character
+// string. Heap strings store pointer, size and capacity, and set the top bit of that last byte.
 class String {
 public:
-    static constexpr std::size_t SSO_LEN{31};
+    static constexpr std::size_t SSO_LEN{23};
+    static constexpr std::size_t npos{std::string_view::npos};
 
-    constexpr String() noexcept : m_length{0} { m_sso[0] = '\0'; }
+    constexpr String() noexcept { m_sso[SSO_LEN] = static_cast<char>(SSO_LEN); }
 
-    String(const char* str) : m_length{std::strlen(str)} {
-        if (m_length <= SSO_LEN) {
-            std::memcpy(m_sso, str, m_length + 1);
-        } else {
-            m_data = new char[m_length + 1];
-            std::memcpy(m_data, str, m_length + 1);
-        }
-    }
+    String(const char* str) : String(std::string_view{str}) {}
 
-    String(std::string_view view) : m_length{view.size()} {
-        if (m_length <= SSO_LEN) {
-            std::memcpy(m_sso, view.data(), m_length);
-            m_sso[m_length] = '\0';
-        } else {
-            m_data = new char[m_length + 1];
-            std::memcpy(m_data, view.data(), m_length);
-            m_data[m_length] = '\0';
-        }
-    }
+    String(std::string_view view) { init(view.data(), view.size()); }
 
-    String(const String& other) : m_length{other.m_length} {
+    String(const String& other) {
         if (other.is_sso()) {
-            std::memcpy(m_sso, other.m_sso, SSO_LEN + 1);
+            std::memcpy(static_cast<void*>(this), &other, sizeof(String));
         } else {
-            m_data = new char[m_length + 1];
-            std::memcpy(m_data, other.m_data, m_length + 1);
+            init(other.m_heap.ptr, other.m_heap.size);
         }
     }
 
-    String(String&& other) noexcept : m_length{other.m_length} {
-        if (other.is_sso()) {
-            std::memcpy(m_sso, other.m_sso, SSO_LEN + 1);
-        } else {
-            m_data = other.m_data;
-            other.m_data = nullptr;
-        }
-        other.m_length = 0;
-    }
-
+    String(String&& other) noexcept { take(other); }
 
     String& operator=(const String& other) {
         if (this != &other) {
-            clear();
-            m_length = other.m_length;
-
-            if (other.is_sso()) {
-                std::memcpy(m_sso, other.m_sso, SSO_LEN + 1);
-            } else {
-                m_data = new char[m_length + 1];
-                std::memcpy(m_data, other.m_data, m_length + 1);
-            }
+            assign(other.data(), other.size());
         }
         return *this;
     }
@@ -70,73 +49,388 @@ public:
     String& operator=(String&& other) noexcept {
         if (this != &other) {
             clear();
-
-            m_length = other.m_length;
-            if (other.is_sso()) {
-                std::memcpy(m_sso, other.m_sso, SSO_LEN + 1);
-            } else {
-                m_data = other.m_data;
-                other.m_data = nullptr;
-            }
-
-            other.m_length = 0;
+            take(other);
         }
         return *this;
     }
 
-
     ~String() { clear(); }
 
     String operator+(const String& other) const {
-        std::size_t new_length = m_length + other.m_length;
         String result;
-        if (new_length <= SSO_LEN) {
-            std::memcpy(result.m_sso, data(), m_length);
-            std::memcpy(result.m_sso + m_length, other.data(), other.m_length);
-            result.m_sso[new_length] = '\0';
-        } else {
-            result.m_data = new char[new_length + 1];
-            std::memcpy(result.m_data, data(), m_length);
-            std::memcpy(result.m_data + m_length, other.data(), other.m_length);
-            result.m_data[new_length] = '\0';
-        }
-        result.m_length = new_length;
+        result.reserve(size() + other.size());
+        result.append(*this);
+        result.append(other);
         return result;
     }
 
+    String& operator+=(const String& other) { return append(other); }
+    String& operator+=(std::string_view view) { return append(view); }
+    String& operator+=(const char* str) { return append(str); }
+    String& operator+=(char ch) {
+        push_back(ch);
+        return *this;
+    }
+
     constexpr auto operator<=>(const String& other) const noexcept {
-        return std::lexicographical_compare_three_way(data(), data() + m_length, other.data(),
-                                                      other.data() + other.m_length);
+        return std::lexicographical_compare_three_way(data(), data() + size(), other.data(),
+                                                      other.data() + other.size());
     }
 
     constexpr bool operator==(const String& other) const noexcept {
-        return m_length == other.m_length && std::memcmp(data(), other.data(), m_length) == 0;
+        return size() == other.size() && std::memcmp(data(), other.data(), size()) == 0;
     }
 
-    [[nodiscard]] constexpr std::size_t size() const noexcept { return m_length; }
-    [[nodiscard]] const char* c_str() const noexcept { return is_sso() ? m_sso : m_data; }
+    friend bool operator==(const String& lhs, std::string_view rhs) noexcept {
+        return lhs.size() == rhs.size() && std::memcmp(lhs.data(), rhs.data(), rhs.size()) == 0;
+    }
+
+    friend bool operator==(const String& lhs, const char* rhs) noexcept { return lhs == std::string_view{rhs}; }
+
+    [[nodiscard]] constexpr std::size_t size() const noexcept {
+        return is_sso() ? SSO_LEN - static_cast<unsigned char>(m_sso[SSO_LEN]) : m_heap.size;
+    }
+    [[nodiscard]] constexpr std::size_t capacity() const noexcept { return is_sso() ? SSO_LEN : heap_capacity(); }
+    [[nodiscard]] const char* c_str() const noexcept { return is_sso() ? m_sso : m_heap.ptr; }
     [[nodiscard]] const char* data() const noexcept { return c_str(); }
 
+    // wyhash of the contents, equal to hashBytes(data(), size()). Computed on every call; keys that
+    // are hashed over and over can be stored as a HashedString instead.
+    [[nodiscard]] std::size_t hash() const noexcept { return static_cast<std::size_t>(hashBytes(data(), size())); }
+
+    // Makes room for at least new_cap characters without changing the contents.
+    void reserve(std::size_t new_cap) {
+        if (new_cap > capacity()) {
+            reallocate(new_cap);
+        }
+    }
+
+    String& append(std::string_view view) {
+        std::size_t length = size();
+        std::size_t new_length = length + view.size();
+        if (new_length > capacity()) {
+            reallocate(next_capacity(new_length), view);
+        } else if (!view.empty()) {
+            std::memcpy(mutable_data() + length, view.data(), view.size());
+        }
+        set_length(new_length);
+        return *this;
+    }
+
+    String& append(const String& other) { return append(std::string_view{other.data(), other.size()}); }
+    String& append(const char* str) { return append(std::string_view{str}); }
+
+    void push_back(char ch) {
+        std::size_t length = size();
+        if (length == capacity()) {
+            reallocate(next_capacity(length + 1));
+        }
+        mutable_data()[length] = ch;
+        set_length(length + 1);
+    }
+
+    // Grows the string to count characters and lets op(data, count) fill them in. op returns the
+    // final length, which must not exceed count; the previous contents are kept in front.
+    template<typename Op>
+    void resize_and_overwrite(std::size_t count, Op op) {
+        if (count > capacity()) {
+            reallocate(next_capacity(count));
+        }
+        std::size_t new_length = static_cast<std::size_t>(std::move(op)(mutable_data(), count));
+        if (new_length > count) {
+            throw std::length_error{"resize_and_overwrite: operation returned a length above count"};
+        }
+        set_length(new_length);
+    }
+
+    // Searches run on the SIMD kernels in str_search.hpp, picked at runtime from the CPU features.
+    [[nodiscard]] std::size_t find(char ch, std::size_t pos = 0) const noexcept {
+        std::size_t length = size();
+        if (pos >= length) {
+            return npos;
+        }
+        std::size_t idx = simdFind(data() + pos, length - pos, ch);
+        return idx == length - pos ? npos : pos + idx;
+    }
+
+    [[nodiscard]] std::size_t find(std::string_view needle, std::size_t pos = 0) const noexcept {
+        std::size_t length = size();
+        if (pos > length) {
+            return npos;
+        }
+        if (needle.empty()) {
+            return pos;
+        }
+        std::size_t idx = simdFind(data() + pos, length - pos, needle.data(), needle.size());
+        return idx == length - pos ? npos : pos + idx;
+    }
+
+    [[nodiscard]] std::size_t rfind(char ch, std::size_t pos = npos) const noexcept {
+        std::size_t end = pos < size() ? pos + 1 : size();
+        std::size_t idx = simdRFind(data(), end, ch);
+        return idx == end ? npos : idx;
+    }
+
+    [[nodiscard]] std::size_t rfind(std::string_view needle, std::size_t pos = npos) const noexcept {
+        std::size_t length = size();
+        if (needle.size() > length) {
+            return npos;
+        }
+        std::size_t last = std::min(pos, length - needle.size());
+        if (needle.empty()) {
+            return last;
+        }
+        std::size_t end = last + needle.size();
+        std::size_t idx = simdRFind(data(), end, needle.data(), needle.size());
+        return idx == end ? npos : idx;
+    }
+
+    [[nodiscard]] bool contains(char ch) const noexcept { return find(ch) != npos; }
+    [[nodiscard]] bool contains(std::string_view needle) const noexcept { return find(needle) != npos; }
+
+    [[nodiscard]] std::size_t count(char ch) const noexcept { return simdCount(data(), size(), ch); }
+
+    // Number of non-overlapping occurrences of needle. An empty needle matches nowhere.
+    [[nodiscard]] std::size_t count(std::string_view needle) const noexcept {
+        if (needle.empty()) {
+            return 0;
+        }
+        std::size_t hits = 0;
+        for (std::size_t pos = find(needle); pos != npos; pos = find(needle, pos + needle.size())) {
+            ++hits;
+        }
+        return hits;
+    }
+
+    // The pieces between delimiters, as string_views into this string. See StrSplitView.
+    [[nodiscard]] StrSplitView<char> split(char delim) const noexcept { return {{data(), size()}, delim}; }
+    [[nodiscard]] StrSplitView<std::string_view> split(std::string_view delim) const noexcept {
+        return {{data(), size()}, delim};
+    }
+
+    [[nodiscard]] bool is_valid_utf8() const noexcept { return simdValidateUtf8(data(), size()); }
+
+    // Number of code points, assuming the contents are valid UTF-8.
+    [[nodiscard]] std::size_t utf8_length() const noexcept { return simdCountUtf8(data(), size()); }
+
+    // The decoded code points. See Utf8View for how malformed bytes are handled.
+    [[nodiscard]] Utf8View code_points() const noexcept { return Utf8View{{data(), size()}}; }
+
+    // Equality ignoring the case of ASCII letters, as HTTP header names and label keys compare.
+    // Non-ASCII bytes must match exactly.
+    [[nodiscard]] bool equals_ignore_case(std::string_view other) const noexcept {
+        return size() == other.size() && simdEqualsIgnoreCase(data(), other.data(), size());
+    }
+
+    // A hash equal for strings that are equals_ignore_case. Not the same value as hash().
+    [[nodiscard]] std::size_t hash_ignore_case() const noexcept {
+        return static_cast<std::size_t>(hashBytesIgnoreCase(data(), size()));
+    }
+
     friend std::ostream& operator<<(std::ostream& os, const String& str) {
         os << str.c_str();
         return os;
     }
 
 private:
+    struct Heap {
+        char* ptr;
+        std::size_t size;
+        std::size_t cap;
+    };
+
+    // The heap flag has to land in the last byte of the object, which is the most significant byte
+    // of cap on little-endian targets and the least significant one on big-endian targets.
+    static constexpr bool LITTLE_ENDIAN_CAP{std::endian::native == std::endian::little};
+    static constexpr unsigned char HEAP_FLAG{0x80};
+    static constexpr unsigned CAP_SHIFT{LITTLE_ENDIAN_CAP ? 0 : 8};
+    static constexpr std::size_t CAP_FLAG{
+        LITTLE_ENDIAN_CAP ? std::size_t{HEAP_FLAG} << (8 * (sizeof(std::size_t) - 1)) : std::size_t{HEAP_FLAG}};
+
     union {
         char m_sso[SSO_LEN + 1]{};
-        char* m_data;
+        Heap m_heap;
     };
 
-    std::size_t m_length{};
+    static_assert(sizeof(Heap) == SSO_LEN + 1);
+
+    [[nodiscard]] constexpr bool is_sso() const noexcept {
+        return (static_cast<unsigned char>(m_sso[SSO_LEN]) & HEAP_FLAG) == 0;
+    }
+
+    [[nodiscard]] constexpr std::size_t heap_capacity() const noexcept {
+        return (m_heap.cap & ~CAP_FLAG) >> CAP_SHIFT;
+    }
+
+    void set_heap(char* ptr, std::size_t length, std::size_t cap) noexcept {
+        m_heap.ptr = ptr;
+        m_heap.size = length;
+        m_heap.cap = (cap << CAP_SHIFT) | CAP_FLAG;
+    }
+
+    [[nodiscard]] std::size_t next_capacity(std::size_t required) const noexcept {
+        return std::max(required, capacity() * 2);
+    }
+
+    [[nodiscard]] char* mutable_data() noexcept { return is_sso() ? m_sso : m_heap.ptr; }
+
+    static char* allocate_heap(std::size_t cap) { return new char[cap + 1]; }
+
+    static void free_heap(char* ptr) noexcept { delete[] ptr; }
+
+    void set_length(std::size_t length) noexcept {
+        mutable_data()[length] = '\0';
+        if (is_sso()) {
+            m_sso[SSO_LEN] = static_cast<char>(SSO_LEN - length);
+        } else {
+            m_heap.size = length;
+        }
+    }
 
-    [[nodiscard]] constexpr bool is_sso() const noexcept { return m_length <= SSO_LEN; }
+    void init(const char* str, std::size_t length) {
+        if (length > SSO_LEN) {
+            set_heap(allocate_heap(length), length, length);
+        } else {
+            m_sso[SSO_LEN] = static_cast<char>(SSO_LEN);
+        }
+        std::memcpy(mutable_data(), str, length);
+        set_length(length);
+    }
+
+    void assign(const char* str, std::size_t length) {
+        if (length > capacity()) {
+            clear();
+            init(str, length);
+            return;
+        }
+        std::memmove(mutable_data(), str, length);
+        set_length(length);
+    }
+
+    // Moves the contents into a new heap buffer of new_cap characters and copies tail after them.
+    // tail may point into the current buffer, which is only freed once it has been copied.
+    void reallocate(std::size_t new_cap, std::string_view tail = {}) {
+        std::size_t length = size();
+        char* buf = allocate_heap(new_cap);
+        std::memcpy(buf, data(), length);
+        if (!tail.empty()) {
+            std::memcpy(buf + length, tail.data(), tail.size());
+        }
+        if (!is_sso()) {
+            free_heap(m_heap.ptr);
+        }
+        set_heap(buf, length, new_cap);
+        buf[length + tail.size()] = '\0';
+    }
+
+    // Takes other's representation, leaving it empty and inline. Expects *this to be empty and inline.
+    void take(String& other) noexcept {
+        std::memcpy(static_cast<void*>(this), &other, sizeof(String));
+        other.reset();
+    }
+
+    void reset() noexcept {
+        std::memset(m_sso, 0, SSO_LEN);
+        m_sso[SSO_LEN] = static_cast<char>(SSO_LEN);
+    }
 
     void clear() noexcept {
-        if (!is_sso() && m_data) {
-            delete[] m_data;
-            m_data = nullptr;
+        if (!is_sso()) {
+            free_heap(m_heap.ptr);
         }
-        m_length = 0;
+        reset();
+    }
+};
+
+static_assert(sizeof(String) == 24);
+
+template<>
+struct std::hash<String> {
+    std::size_t operator()(const String& str) const noexcept { return str.hash(); }
+};
+
+// An immutable String stored with its hash, computed once on construction, for keys that are
+// hashed over and over (HashMap rehashes, repeated interner or map lookups). It costs 8 bytes more
+// than a String, so plain Strings do not carry a hash cache.
+class HashedString {
+public:
+    HashedString() noexcept : m_hash{static_cast<std::size_t>(hashBytes("", 0))} {}
+
+    HashedString(String str) noexcept : m_str{std::move(str)}, m_hash{m_str.hash()} {}
+    HashedString(std::string_view view) : HashedString(String{view}) {}
+    HashedString(const char* str) : HashedString(String{str}) {}
+
+    [[nodiscard]] const String& str() const noexcept { return m_str; }
+    [[nodiscard]] const char* data() const noexcept { return m_str.data(); }
+    [[nodiscard]] const char* c_str() const noexcept { return m_str.c_str(); }
+    [[nodiscard]] std::size_t size() const noexcept { return m_str.size(); }
+    [[nodiscard]] bool empty() const noexcept { return m_str.size() == 0; }
+    [[nodiscard]] std::string_view view() const noexcept { return {m_str.data(), m_str.size()}; }
+
+    // Same value as String::hash() of an equal String, without touching the characters.
+    [[nodiscard]] std::size_t hash() const noexcept { return m_hash; }
+
+    operator std::string_view() const noexcept { return view(); }
+
+    // Different hashes settle inequality without comparing the characters.
+    friend bool operator==(const HashedString& lhs, const HashedString& rhs) noexcept {
+        return lhs.m_hash == rhs.m_hash && lhs.m_str == rhs.m_str;
+    }
+    friend bool operator==(const HashedString& lhs, std::string_view rhs) noexcept { return lhs.m_str == rhs; }
+    friend bool operator==(const HashedString& lhs, const char* rhs) noexcept { return lhs.m_str == rhs; }
+    friend auto operator<=>(const HashedString& lhs, const HashedString& rhs) noexcept {
+        return lhs.view() <=> rhs.view();
+    }
+
+    friend std::ostream& operator<<(std::ostream& os, const HashedString& str) { return os << str.m_str; }
+
+private:
+    String m_str;
+    std::size_t m_hash;
+};
+
+static_assert(sizeof(HashedString) == 32);
+
+template<>
+struct std::hash<HashedString> {
+    std::size_t operator()(const HashedString& str) const noexcept { return str.hash(); }
+};
+
+// Transparent hasher for String keys: lookups by string_view or const char* hash to the same value
+// as the equal String, so unordered containers can use them without building a String. Pair it
+// with std::equal_to<>.
+struct StringHash {
+    using is_transparent = void;
+
+    std::size_t operator()(const String& str) const noexcept { return str.hash(); }
+    std::size_t operator()(const HashedString& str) const noexcept { return str.hash(); }
+    std::size_t operator()(std::string_view view) const noexcept {
+        return static_cast<std::size_t>(hashBytes(view.data(), view.size()));
+    }
+    std::size_t operator()(const char* str) const noexcept { return (*this)(std::string_view{str}); }
+};
+
+// Transparent hasher and equality ignoring ASCII case, for maps keyed by header names:
+// std::unordered_map<String, V, StringHashIgnoreCase, StringEqualIgnoreCase>.
+struct StringHashIgnoreCase {
+    using is_transparent = void;
+
+    std::size_t operator()(std::string_view view) const noexcept {
+        return static_cast<std::size_t>(hashBytesIgnoreCase(view.data(), view.size()));
+    }
+    std::size_t operator()(const String& str) const noexcept { return str.hash_ignore_case(); }
+    std::size_t operator()(const char* str) const noexcept { return (*this)(std::string_view{str}); }
+};
+
+struct StringEqualIgnoreCase {
+    using is_transparent = void;
+
+    bool operator()(std::string_view lhs, std::string_view rhs) const noexcept {
+        return lhs.size() == rhs.size() && simdEqualsIgnoreCase(lhs.data(), rhs.data(), lhs.size());
+    }
+    bool operator()(const String& lhs, std::string_view rhs) const noexcept { return lhs.equals_ignore_case(rhs); }
+    bool operator()(std::string_view lhs, const String& rhs) const noexcept { return rhs.equals_ignore_case(lhs); }
+    bool operator()(const String& lhs, const String& rhs) const noexcept {
+        return lhs.equals_ignore_case({rhs.data(), rhs.size()});
     }
 };
@@ -0,0 +1,266 @@
+#pragma once
+
+#include <algorithm>
+#include <cerrno>
+#include <cstddef>
+#include <exception>
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <thread>
+#include <utility>
+#include <vector>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "../simd/str_search.hpp"
+#include "my_string.hpp"
+
+// Streams the delimiter-separated records of a file as std::string_views without copying them.
+// The file is mapped read-only when possible; otherwise (or when asked to) it is read in large
+// blocks with pread, carrying a record that straddles two blocks over into the next read. A
+// trailing delimiter ends the last record rather than starting an empty one, so a file of lines
+// yields one record per line. Delimiters are found with simdFind.
+//
+// Records handed to callbacks point into the mapping, which lives as long as the reader, or into
+// the read buffer, which is reused for the next block; copy them (to_strings()) to keep them.
+class RecordReader {
+public:
+    enum class Backend { Auto, Map, Read };
+
+    struct Options {
+        char delim{'\n'};
+        Backend backend{Backend::Auto};
+        // Initial pread block size; it grows if a single record does not fit.
+        std::size_t block_len{1 << 20};
+    };
+
+    // Throws std::system_error if the file cannot be opened, or mapped with Backend::Map.
+    explicit RecordReader(const std::filesystem::path& path) : RecordReader(path, Options{}) {}
+
+    RecordReader(const std::filesystem::path& path, Options options) : m_options{options} {
+        m_options.block_len = std::max<std::size_t>(m_options.block_len, 1);
+        m_fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+        if (m_fd < 0) {
+            throw_errno("open");
+        }
+        struct stat st{};
+        if (::fstat(m_fd, &st) != 0) {
+            close_on_error("fstat");
+        }
+        m_size = static_cast<std::size_t>(st.st_size);
+        if (m_size == 0 || m_options.backend == Backend::Read) {
+            return;
+        }
+        void* map = ::mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, m_fd, 0);
+        if (map == MAP_FAILED) {
+            if (m_options.backend == Backend::Map) {
+                close_on_error("mmap");
+            }
+            return;
+        }
+        ::madvise(map, m_size, MADV_SEQUENTIAL);
+        m_map = static_cast<const char*>(map);
+    }
+
+    RecordReader(const RecordReader&) = delete;
+    RecordReader& operator=(const RecordReader&) = delete;
+
+    RecordReader(RecordReader&& other) noexcept
+        : m_options{other.m_options}, m_fd{std::exchange(other.m_fd, -1)}, m_map{std::exchange(other.m_map, nullptr)},
+          m_size{std::exchange(other.m_size, 0)} {}
+
+    RecordReader& operator=(RecordReader&& other) noexcept {
+        if (this != &other) {
+            release();
+            m_options = other.m_options;
+            m_fd = std::exchange(other.m_fd, -1);
+            m_map = std::exchange(other.m_map, nullptr);
+            m_size = std::exchange(other.m_size, 0);
+        }
+        return *this;
+    }
+
+    ~RecordReader() { release(); }
+
+    [[nodiscard]] std::size_t file_size() const noexcept { return m_size; }
+    [[nodiscard]] bool mapped() const noexcept { return m_map != nullptr; }
+
+    // Calls fn(std::string_view record) for every record, in file order.
+    template<typename Fn>
+    void for_each(Fn&& fn) const {
+        scan(0, m_size, fn);
+    }
+
+    // Splits the file into up to threads byte ranges and calls fn(std::string_view record,
+    // std::size_t worker) from that many threads at once. A record belongs to the range it starts
+    // in, so every record is seen exactly once; order across workers is unspecified. The first
+    // exception thrown by a worker is rethrown once all of them have finished.
+    template<typename Fn>
+    void for_each_parallel(std::size_t threads, Fn&& fn) const {
+        threads = std::clamp<std::size_t>(threads, 1, std::max<std::size_t>(m_size, 1));
+        if (threads == 1) {
+            scan(0, m_size, [&](std::string_view record) { fn(record, std::size_t{0}); });
+            return;
+        }
+        std::vector<std::exception_ptr> errors(threads);
+        std::vector<std::thread> workers;
+        workers.reserve(threads);
+        for (std::size_t t = 0; t < threads; ++t) {
+            workers.emplace_back([&, t] {
+                try {
+                    scan(m_size * t / threads, m_size * (t + 1) / threads,
+                         [&](std::string_view record) { fn(record, t); });
+                } catch (...) {
+                    errors[t] = std::current_exception();
+                }
+            });
+        }
+        for (auto& worker: workers) {
+            worker.join();
+        }
+        for (auto& error: errors) {
+            if (error) {
+                std::rethrow_exception(error);
+            }
+        }
+    }
+
+    // Copies every record into an owning String.
+    [[nodiscard]] std::vector<String> to_strings() const {
+        std::vector<String> records;
+        for_each([&](std::string_view record) { records.emplace_back(record); });
+        return records;
+    }
+
+private:
+    Options m_options;
+    int m_fd{-1};
+    const char* m_map{nullptr};
+    std::size_t m_size{0};
+
+    [[noreturn]] static void throw_errno(const char* what) {
+        throw std::system_error{errno, std::generic_category(), std::string{"RecordReader: "} + what};
+    }
+
+    [[noreturn]] void close_on_error(const char* what) {
+        int err = errno;
+        ::close(m_fd);
+        m_fd = -1;
+        errno = err;
+        throw_errno(what);
+    }
+
+    void release() noexcept {
+        if (m_map) {
+            ::munmap(const_cast<char*>(m_map), m_size);
+            m_map = nullptr;
+        }
+        if (m_fd >= 0) {
+            ::close(m_fd);
+            m_fd = -1;
+        }
+    }
+
+    // Visits the records that start in [begin, end). Scanning starts one byte early: whatever
+    // precedes the first delimiter from there belongs to a record started before begin, and if
+    // that byte is itself a delimiter, a record starts exactly at begin.
+    template<typename Fn>
+    void scan(std::size_t begin, std::size_t end, Fn&& fn) const {
+        if (begin >= end) {
+            return;
+        }
+        if (m_map) {
+            scan_mapped(begin, end, fn);
+        } else {
+            scan_read(begin, end, fn);
+        }
+    }
+
+    template<typename Fn>
+    void scan_mapped(std::size_t begin, std::size_t end, Fn&& fn) const {
+        const char delim = m_options.delim;
+        std::size_t pos = 0;
+        if (begin > 0) {
+            pos = begin - 1 + simdFind(m_map + begin - 1, m_size - begin + 1, delim) + 1;
+        }
+        while (pos < end) {
+            std::size_t len = simdFind(m_map + pos, m_size - pos, delim);
+            fn(std::string_view{m_map + pos, len});
+            pos += len + 1;
+        }
+    }
+
+    template<typename Fn>
+    void scan_read(std::size_t begin, std::size_t end, Fn&& fn) const {
+        const char delim = m_options.delim;
+        std::size_t cap = m_options.block_len;
+        auto buf = std::make_unique_for_overwrite<char[]>(cap);
+        // buf holds the file bytes [buf_off, buf_off + have); next_read is where the next pread starts.
+        std::size_t next_read = begin > 0 ? begin - 1 : 0;
+        std::size_t buf_off = next_read;
+        std::size_t have = 0;
+        bool skipping = begin > 0;
+
+        while (true) {
+            while (have < cap && next_read < m_size) {
+                ssize_t n = ::pread(m_fd, buf.get() + have, std::min(cap - have, m_size - next_read),
+                                    static_cast<off_t>(next_read));
+                if (n < 0) {
+                    if (errno == EINTR) {
+                        continue;
+                    }
+                    throw_errno("pread");
+                }
+                if (n == 0) {
+                    break;
+                }
+                have += static_cast<std::size_t>(n);
+                next_read += static_cast<std::size_t>(n);
+            }
+            bool eof = have < cap || next_read >= m_size;
+
+            std::size_t pos = 0;
+            if (skipping) {
+                std::size_t idx = simdFind(buf.get(), have, delim);
+                if (idx == have) {
+                    if (eof) {
+                        return;
+                    }
+                    buf_off += have;
+                    have = 0;
+                    continue;
+                }
+                pos = idx + 1;
+                skipping = false;
+            }
+            while (pos < have && buf_off + pos < end) {
+                std::size_t len = simdFind(buf.get() + pos, have - pos, delim);
+                if (len == have - pos && !eof) {
+                    break;
+                }
+                fn(std::string_view{buf.get() + pos, len});
+                pos += len + 1;
+            }
+            if (eof || buf_off + pos >= end) {
+                return;
+            }
+
+            // Carry the unfinished record to the front, growing the buffer if it fills it.
+            std::size_t tail = have - pos;
+            if (tail == cap) {
+                cap *= 2;
+                auto bigger = std::make_unique_for_overwrite<char[]>(cap);
+                std::copy_n(buf.get(), tail, bigger.get());
+                buf = std::move(bigger);
+            } else {
+                std::copy_n(buf.get() + pos, tail, buf.get());
+            }
+            buf_off += pos;
+            have = tail;
+        }
+    }
+};
@@ -0,0 +1,200 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <compare>
+#include <cstddef>
+#include <cstring>
+#include <functional>
+#include <new>
+#include <ostream>
+#include <stdexcept>
+#include <string_view>
+#include <utility>
+#include "my_string.hpp"
+#include "str_hash.hpp"
+
+// A string whose heap buffer is shared between copies through an atomic reference count, for large
+// payloads passed along a pipeline. Copying and substr() are O(1) and never touch the characters;
+// each SharedString is a view (pointer and length) into a buffer it co-owns. Appending writes in
+// place only when this is the sole owner and the view ends where the buffer's contents do;
+// otherwise the view is first copied into a buffer of its own (copy on write).
+//
+// The characters are not null-terminated, since a substring can end in the middle of a buffer.
+class SharedString {
+public:
+    static constexpr std::size_t npos{std::string_view::npos};
+
+    SharedString() noexcept = default;
+
+    SharedString(std::string_view view) {
+        if (!view.empty()) {
+            m_buf = Buffer::create(view.size());
+            std::memcpy(m_buf->chars(), view.data(), view.size());
+            m_buf->used = view.size();
+            m_ptr = m_buf->chars();
+            m_size = view.size();
+        }
+    }
+
+    SharedString(const char* str) : SharedString(std::string_view{str}) {}
+    explicit SharedString(const String& str) : SharedString(std::string_view{str.data(), str.size()}) {}
+
+    SharedString(const SharedString& other) noexcept : m_buf{other.m_buf}, m_ptr{other.m_ptr}, m_size{other.m_size} {
+        if (m_buf) {
+            m_buf->refs.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    SharedString(SharedString&& other) noexcept
+        : m_buf{std::exchange(other.m_buf, nullptr)}, m_ptr{std::exchange(other.m_ptr, "")},
+          m_size{std::exchange(other.m_size, 0)} {}
+
+    SharedString& operator=(const SharedString& other) noexcept {
+        SharedString copy{other};
+        swap(copy);
+        return *this;
+    }
+
+    SharedString& operator=(SharedString&& other) noexcept {
+        SharedString moved{std::move(other)};
+        swap(moved);
+        return *this;
+    }
+
+    ~SharedString() { release(); }
+
+    void swap(SharedString& other) noexcept {
+        std::swap(m_buf, other.m_buf);
+        std::swap(m_ptr, other.m_ptr);
+        std::swap(m_size, other.m_size);
+    }
+
+    [[nodiscard]] const char* data() const noexcept { return m_ptr; }
+    [[nodiscard]] std::size_t size() const noexcept { return m_size; }
+    [[nodiscard]] bool empty() const noexcept { return m_size == 0; }
+    [[nodiscard]] std::string_view view() const noexcept { return {m_ptr, m_size}; }
+    operator std::string_view() const noexcept { return view(); }
+
+    [[nodiscard]] const char& operator[](std::size_t index) const noexcept { return m_ptr[index]; }
+
+    [[nodiscard]] const char& at(std::size_t index) const {
+        if (index >= m_size) {
+            throw std::out_of_range("SharedString index out of range");
+        }
+        return m_ptr[index];
+    }
+
+    [[nodiscard]] const char* begin() const noexcept { return m_ptr; }
+    [[nodiscard]] const char* end() const noexcept { return m_ptr + m_size; }
+
+    // Number of SharedStrings sharing this buffer, 0 for an empty string without one.
+    [[nodiscard]] std::size_t use_count() const noexcept {
+        return m_buf ? m_buf->refs.load(std::memory_order_relaxed) : 0;
+    }
+
+    // The characters [pos, pos + len), sharing this string's buffer.
+    [[nodiscard]] SharedString substr(std::size_t pos, std::size_t len = npos) const {
+        if (pos > m_size) {
+            throw std::out_of_range("SharedString::substr position out of range");
+        }
+        SharedString piece{*this};
+        piece.m_ptr += pos;
+        piece.m_size = std::min(len, m_size - pos);
+        return piece;
+    }
+
+    SharedString& append(std::string_view view) {
+        if (view.empty()) {
+            return *this;
+        }
+        if (can_write_in_place(view.size())) {
+            std::memcpy(m_buf->chars() + m_buf->used, view.data(), view.size());
+            m_buf->used += view.size();
+            m_size += view.size();
+            return *this;
+        }
+        // Copy on write. view may point into the old buffer, so that is released after the copy.
+        Buffer* fresh = Buffer::create(std::max(m_size + view.size(), 2 * m_size));
+        std::memcpy(fresh->chars(), m_ptr, m_size);
+        std::memcpy(fresh->chars() + m_size, view.data(), view.size());
+        fresh->used = m_size + view.size();
+        release();
+        m_buf = fresh;
+        m_ptr = fresh->chars();
+        m_size = fresh->used;
+        return *this;
+    }
+
+    SharedString& operator+=(std::string_view view) { return append(view); }
+    SharedString& operator+=(const SharedString& other) { return append(other.view()); }
+    SharedString& operator+=(const char* str) { return append(str); }
+    SharedString& operator+=(char ch) { return append({&ch, 1}); }
+
+    void clear() noexcept {
+        release();
+        m_buf = nullptr;
+        m_ptr = "";
+        m_size = 0;
+    }
+
+    // Same value as String::hash() of an equal String.
+    [[nodiscard]] std::size_t hash() const noexcept { return static_cast<std::size_t>(hashBytes(m_ptr, m_size)); }
+
+    // Copies the characters into an owning, mutable String.
+    [[nodiscard]] String to_string() const { return String{view()}; }
+    explicit operator String() const { return to_string(); }
+
+    friend bool operator==(const SharedString& lhs, const SharedString& rhs) noexcept {
+        return lhs.view() == rhs.view();
+    }
+    friend bool operator==(const SharedString& lhs, std::string_view rhs) noexcept { return lhs.view() == rhs; }
+    friend bool operator==(const SharedString& lhs, const char* rhs) noexcept { return lhs.view() == rhs; }
+    friend auto operator<=>(const SharedString& lhs, const SharedString& rhs) noexcept {
+        return lhs.view() <=> rhs.view();
+    }
+
+    friend std::ostream& operator<<(std::ostream& os, const SharedString& str) { return os << str.view(); }
+
+private:
+    // Reference count and sizes, followed in the same allocation by capacity characters.
+    struct Buffer {
+        std::atomic<std::size_t> refs{1};
+        std::size_t capacity;
+        // Characters written so far; views never extend past this.
+        std::size_t used{0};
+
+        explicit Buffer(std::size_t cap) noexcept : capacity{cap} {}
+
+        char* chars() noexcept { return reinterpret_cast<char*>(this + 1); }
+
+        static Buffer* create(std::size_t cap) { return ::new (::operator new(sizeof(Buffer) + cap)) Buffer{cap}; }
+
+        static void destroy(Buffer* buf) noexcept {
+            buf->~Buffer();
+            ::operator delete(buf);
+        }
+    };
+
+    Buffer* m_buf{nullptr};
+    // Points at a shared empty string when there is no buffer.
+    const char* m_ptr{""};
+    std::size_t m_size{0};
+
+    // Sole owner, the view reaches the end of the written characters, and extra more bytes fit.
+    [[nodiscard]] bool can_write_in_place(std::size_t extra) const noexcept {
+        return m_buf && m_buf->refs.load(std::memory_order_acquire) == 1 &&
+               m_ptr + m_size == m_buf->chars() + m_buf->used && m_buf->used + extra <= m_buf->capacity;
+    }
+
+    void release() noexcept {
+        if (m_buf && m_buf->refs.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            Buffer::destroy(m_buf);
+        }
+    }
+};
+
+template<>
+struct std::hash<SharedString> {
+    std::size_t operator()(const SharedString& str) const noexcept { return str.hash(); }
+};
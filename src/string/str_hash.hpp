@@ -0,0 +1,120 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include "../simd/utf8.hpp"
+
+// wyhash (final version 4): a fast, well-mixed 64-bit hash for byte strings. Inputs up to 16
+// bytes take two overlapping loads and one multiply; longer inputs are consumed 48 bytes at a
+// time through three independent multiply chains.
+struct WyHash {
+    static constexpr std::uint64_t secret[4] = {0x2d358dccaa6c78a5ull, 0x8bb84b93962eacc9ull, 0x4b33a62ed433d4a3ull,
+                                                0x4d5a2da51de1aa47ull};
+
+    // Full 64x64 -> 128 bit multiply; a receives the low half and b the high half.
+    static void mum(std::uint64_t& a, std::uint64_t& b) noexcept {
+#if defined(__SIZEOF_INT128__)
+        unsigned __int128 r = static_cast<unsigned __int128>(a) * b;
+        a = static_cast<std::uint64_t>(r);
+        b = static_cast<std::uint64_t>(r >> 64);
+#else
+        std::uint64_t ha = a >> 32, hb = b >> 32, la = static_cast<std::uint32_t>(a), lb = static_cast<std::uint32_t>(b);
+        std::uint64_t rh = ha * hb, rm0 = ha * lb, rm1 = hb * la, rl = la * lb;
+        std::uint64_t t = rl + (rm0 << 32);
+        std::uint64_t c = t < rl;
+        std::uint64_t lo = t + (rm1 << 32);
+        c += lo < t;
+        std::uint64_t hi = rh + (rm0 >> 32) + (rm1 >> 32) + c;
+        a = lo;
+        b = hi;
+#endif
+    }
+
+    static std::uint64_t mix(std::uint64_t a, std::uint64_t b) noexcept {
+        mum(a, b);
+        return a ^ b;
+    }
+
+    static std::uint64_t read8(const unsigned char* p) noexcept {
+        std::uint64_t v;
+        std::memcpy(&v, p, 8);
+        return v;
+    }
+
+    static std::uint64_t read4(const unsigned char* p) noexcept {
+        std::uint32_t v;
+        std::memcpy(&v, p, 4);
+        return v;
+    }
+
+    static std::uint64_t read3(const unsigned char* p, std::size_t k) noexcept {
+        return (static_cast<std::uint64_t>(p[0]) << 16) | (static_cast<std::uint64_t>(p[k >> 1]) << 8) | p[k - 1];
+    }
+
+    static std::uint64_t hash(const void* key, std::size_t len, std::uint64_t seed) noexcept {
+        const auto* p = static_cast<const unsigned char*>(key);
+        seed ^= mix(seed ^ secret[0], secret[1]);
+        std::uint64_t a;
+        std::uint64_t b;
+        if (len <= 16) {
+            if (len >= 4) {
+                std::size_t off = (len >> 3) << 2;
+                a = (read4(p) << 32) | read4(p + off);
+                b = (read4(p + len - 4) << 32) | read4(p + len - 4 - off);
+            } else if (len > 0) {
+                a = read3(p, len);
+                b = 0;
+            } else {
+                a = b = 0;
+            }
+        } else {
+            std::size_t i = len;
+            if (i > 48) {
+                std::uint64_t see1 = seed;
+                std::uint64_t see2 = seed;
+                do {
+                    seed = mix(read8(p) ^ secret[1], read8(p + 8) ^ seed);
+                    see1 = mix(read8(p + 16) ^ secret[2], read8(p + 24) ^ see1);
+                    see2 = mix(read8(p + 32) ^ secret[3], read8(p + 40) ^ see2);
+                    p += 48;
+                    i -= 48;
+                } while (i > 48);
+                seed ^= see1 ^ see2;
+            }
+            while (i > 16) {
+                seed = mix(read8(p) ^ secret[1], read8(p + 8) ^ seed);
+                i -= 16;
+                p += 16;
+            }
+            a = read8(p + i - 16);
+            b = read8(p + i - 8);
+        }
+        a ^= secret[1];
+        b ^= seed;
+        mum(a, b);
+        return mix(a ^ secret[0] ^ len, b ^ secret[1]);
+    }
+};
+
+// Hash of the bytes [data, data + len).
+inline std::uint64_t hashBytes(const void* data, std::size_t len, std::uint64_t seed = 0) noexcept {
+    return WyHash::hash(data, len, seed);
+}
+
+// Hash of [data, data + len) with ASCII letters lowercased, so strings differing only in ASCII case
+// hash alike. Folds through a stack buffer; inputs up to its size hash as hashBytes of the folded
+// bytes, longer ones chain the buffer-sized pieces through the seed.
+inline std::uint64_t hashBytesIgnoreCase(const void* data, std::size_t len, std::uint64_t seed = 0) noexcept {
+    constexpr std::size_t BUF_LEN = 256;
+    char buf[BUF_LEN];
+    const auto* p = static_cast<const char*>(data);
+    do {
+        std::size_t piece = len < BUF_LEN ? len : BUF_LEN;
+        simdFoldCase(p, buf, piece);
+        seed = WyHash::hash(buf, piece, seed);
+        p += piece;
+        len -= piece;
+    } while (len > 0);
+    return seed;
+}
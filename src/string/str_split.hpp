@@ -0,0 +1,90 @@
+#pragma once
+
+#include <cstddef>
+#include <iterator>
+#include <ranges>
+#include <string_view>
+#include <type_traits>
+#include "../simd/str_search.hpp"
+
+// A lazy range over the pieces of a string separated by delim, which is a char or a
+// std::string_view. Pieces are string_views into the original string, so iterating allocates
+// nothing. Like std::views::split, an empty string has no pieces and a trailing delimiter yields
+// a trailing empty piece. An empty delimiter never matches.
+template<typename Delim>
+class StrSplitView : public std::ranges::view_interface<StrSplitView<Delim>> {
+    static_assert(std::is_same_v<Delim, char> || std::is_same_v<Delim, std::string_view>);
+
+public:
+    class iterator {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = std::string_view;
+        using difference_type = std::ptrdiff_t;
+
+        iterator() = default;
+
+        std::string_view operator*() const noexcept { return m_piece; }
+
+        iterator& operator++() noexcept {
+            advance();
+            return *this;
+        }
+
+        iterator operator++(int) noexcept {
+            iterator tmp{*this};
+            advance();
+            return tmp;
+        }
+
+        friend bool operator==(const iterator& a, const iterator& b) noexcept {
+            return a.m_done == b.m_done && (a.m_done || a.m_piece.data() == b.m_piece.data());
+        }
+        friend bool operator==(const iterator& it, std::default_sentinel_t) noexcept { return it.m_done; }
+
+    private:
+        friend class StrSplitView;
+
+        iterator(std::string_view str, Delim delim) noexcept : m_rest{str}, m_delim{delim}, m_more{!str.empty()} {
+            advance();
+        }
+
+        std::string_view m_rest;
+        std::string_view m_piece;
+        Delim m_delim{};
+        // Whether another piece follows the current one, possibly empty.
+        bool m_more{false};
+        bool m_done{false};
+
+        void advance() noexcept {
+            if (!m_more) {
+                m_done = true;
+                return;
+            }
+            std::size_t pos;
+            std::size_t delimLen;
+            if constexpr (std::is_same_v<Delim, char>) {
+                pos = simdFind(m_rest.data(), m_rest.size(), m_delim);
+                delimLen = 1;
+            } else {
+                pos = m_delim.empty() ? m_rest.size()
+                                      : simdFind(m_rest.data(), m_rest.size(), m_delim.data(), m_delim.size());
+                delimLen = m_delim.size();
+            }
+            m_piece = m_rest.substr(0, pos);
+            m_more = pos != m_rest.size();
+            m_rest = m_more ? m_rest.substr(pos + delimLen) : std::string_view{};
+        }
+    };
+
+    StrSplitView() = default;
+
+    StrSplitView(std::string_view str, Delim delim) noexcept : m_str{str}, m_delim{delim} {}
+
+    [[nodiscard]] iterator begin() const noexcept { return iterator{m_str, m_delim}; }
+    [[nodiscard]] std::default_sentinel_t end() const noexcept { return std::default_sentinel; }
+
+private:
+    std::string_view m_str;
+    Delim m_delim{};
+};
@@ -0,0 +1,171 @@
+#pragma once
+
+#include <cstddef>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <ostream>
+#include <stdexcept>
+#include <string_view>
+#include <utility>
+#include <vector>
+#include "my_string.hpp"
+#include "str_hash.hpp"
+
+// An immutable, null-terminated string whose bytes live in a StringArena. It is a pointer and a
+// length, so copying it is free; it stays valid until its arena is released or destroyed.
+class ArenaString {
+public:
+    constexpr ArenaString() noexcept = default;
+
+    [[nodiscard]] const char* data() const noexcept { return m_ptr; }
+    [[nodiscard]] const char* c_str() const noexcept { return m_ptr; }
+    [[nodiscard]] std::size_t size() const noexcept { return m_size; }
+    [[nodiscard]] bool empty() const noexcept { return m_size == 0; }
+    [[nodiscard]] std::string_view view() const noexcept { return {m_ptr, m_size}; }
+
+    [[nodiscard]] const char& operator[](std::size_t index) const noexcept { return m_ptr[index]; }
+
+    [[nodiscard]] const char& at(std::size_t index) const {
+        if (index >= m_size) {
+            throw std::out_of_range("ArenaString index out of range");
+        }
+        return m_ptr[index];
+    }
+
+    [[nodiscard]] const char* begin() const noexcept { return m_ptr; }
+    [[nodiscard]] const char* end() const noexcept { return m_ptr + m_size; }
+
+    // Same value as String::hash() of an equal String.
+    [[nodiscard]] std::size_t hash() const noexcept { return static_cast<std::size_t>(hashBytes(m_ptr, m_size)); }
+
+    operator std::string_view() const noexcept { return view(); }
+
+    // Copies the bytes out of the arena into an owning String.
+    [[nodiscard]] String to_string() const { return String{view()}; }
+    explicit operator String() const { return to_string(); }
+
+    friend bool operator==(const ArenaString& lhs, const ArenaString& rhs) noexcept { return lhs.view() == rhs.view(); }
+    friend bool operator==(const ArenaString& lhs, std::string_view rhs) noexcept { return lhs.view() == rhs; }
+    friend bool operator==(const ArenaString& lhs, const char* rhs) noexcept { return lhs.view() == rhs; }
+    friend auto operator<=>(const ArenaString& lhs, const ArenaString& rhs) noexcept { return lhs.view() <=> rhs.view(); }
+
+    friend std::ostream& operator<<(std::ostream& os, const ArenaString& str) { return os << str.view(); }
+
+private:
+    friend class StringArena;
+
+    ArenaString(const char* ptr, std::size_t size) noexcept : m_ptr{ptr}, m_size{size} {}
+
+    // Points at a shared empty string, so c_str() is always valid.
+    const char* m_ptr{""};
+    std::size_t m_size{0};
+};
+
+template<>
+struct std::hash<ArenaString> {
+    std::size_t operator()(const ArenaString& str) const noexcept { return str.hash(); }
+};
+
+// A bump allocator for string bytes. Strings are copied into large chunks one after another, so
+// storing one is a bounds check and a memcpy, and release() frees every string at once with one
+// delete[] per chunk. Strings larger than a quarter chunk get a chunk of their own, so they do not
+// waste the tail of the current one.
+class StringArena {
+public:
+    static constexpr std::size_t CHUNK_LEN{64 * 1024};
+
+    StringArena() noexcept = default;
+
+    explicit StringArena(std::size_t chunk_len) : m_chunk_len{chunk_len} {
+        if (chunk_len == 0) {
+            throw std::invalid_argument("StringArena chunk length must be positive");
+        }
+    }
+
+    StringArena(const StringArena&) = delete;
+    StringArena& operator=(const StringArena&) = delete;
+
+    StringArena(StringArena&& other) noexcept
+        : m_chunks{std::move(other.m_chunks)}, m_cur{std::exchange(other.m_cur, nullptr)},
+          m_end{std::exchange(other.m_end, nullptr)}, m_chunk_len{other.m_chunk_len},
+          m_used{std::exchange(other.m_used, 0)}, m_reserved{std::exchange(other.m_reserved, 0)} {}
+
+    StringArena& operator=(StringArena&& other) noexcept {
+        if (this != &other) {
+            m_chunks = std::move(other.m_chunks);
+            m_cur = std::exchange(other.m_cur, nullptr);
+            m_end = std::exchange(other.m_end, nullptr);
+            m_chunk_len = other.m_chunk_len;
+            m_used = std::exchange(other.m_used, 0);
+            m_reserved = std::exchange(other.m_reserved, 0);
+        }
+        return *this;
+    }
+
+    ~StringArena() = default;
+
+    // Copies view into the arena, followed by a terminating '\0'.
+    ArenaString store(std::string_view view) {
+        char* buf = allocate(view.size() + 1);
+        if (!view.empty()) {
+            std::memcpy(buf, view.data(), view.size());
+        }
+        buf[view.size()] = '\0';
+        return ArenaString{buf, view.size()};
+    }
+
+    ArenaString store(const String& str) { return store(std::string_view{str.data(), str.size()}); }
+    ArenaString store(const char* str) { return store(std::string_view{str}); }
+
+    // Returns size uninitialized bytes, valid until the arena is released.
+    [[nodiscard]] char* allocate(std::size_t size) {
+        if (static_cast<std::size_t>(m_end - m_cur) < size) {
+            return allocate_slow(size);
+        }
+        char* buf = m_cur;
+        m_cur += size;
+        m_used += size;
+        return buf;
+    }
+
+    // Frees every string stored so far. All ArenaStrings from this arena are invalidated.
+    void release() noexcept {
+        m_chunks.clear();
+        m_cur = m_end = nullptr;
+        m_used = 0;
+        m_reserved = 0;
+    }
+
+    // Bytes handed out, including terminators.
+    [[nodiscard]] std::size_t bytes_used() const noexcept { return m_used; }
+    // Bytes held in chunks.
+    [[nodiscard]] std::size_t bytes_reserved() const noexcept { return m_reserved; }
+    [[nodiscard]] std::size_t chunk_count() const noexcept { return m_chunks.size(); }
+
+private:
+    std::vector<std::unique_ptr<char[]>> m_chunks;
+    char* m_cur{nullptr};
+    char* m_end{nullptr};
+    std::size_t m_chunk_len{CHUNK_LEN};
+    std::size_t m_used{0};
+    std::size_t m_reserved{0};
+
+    char* allocate_slow(std::size_t size) {
+        if (size > m_chunk_len / 4) {
+            // Oversized: give it a dedicated chunk and keep bumping in the current one.
+            m_chunks.push_back(std::make_unique_for_overwrite<char[]>(size));
+            m_reserved += size;
+            m_used += size;
+            return m_chunks.back().get();
+        }
+        m_chunks.push_back(std::make_unique_for_overwrite<char[]>(m_chunk_len));
+        m_reserved += m_chunk_len;
+        m_cur = m_chunks.back().get();
+        m_end = m_cur + m_chunk_len;
+        char* buf = m_cur;
+        m_cur += size;
+        m_used += size;
+        return buf;
+    }
+};
@@ -0,0 +1,147 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <limits>
+#include <mutex>
+#include <optional>
+#include <shared_mutex>
+#include <stdexcept>
+#include <string_view>
+#include <unordered_map>
+#include "my_string.hpp"
+
+class StringInterner;
+
+// A handle to a string owned by a StringInterner. Atoms from the same interner are equal exactly
+// when their ids are, so comparison is a single integer compare, and hash() returns the hash
+// computed once at interning time. The referenced String lives as long as the interner.
+class Atom {
+public:
+    Atom() noexcept = default;
+
+    [[nodiscard]] std::uint32_t id() const noexcept { return m_id; }
+    [[nodiscard]] std::size_t hash() const noexcept { return m_entry ? m_entry->hash : 0; }
+    [[nodiscard]] const String& str() const noexcept { return m_entry->text; }
+    [[nodiscard]] std::string_view view() const noexcept {
+        return m_entry ? std::string_view{m_entry->text.data(), m_entry->text.size()} : std::string_view{};
+    }
+    explicit operator bool() const noexcept { return m_entry != nullptr; }
+
+    friend bool operator==(const Atom& lhs, const Atom& rhs) noexcept { return lhs.m_id == rhs.m_id; }
+    friend auto operator<=>(const Atom& lhs, const Atom& rhs) noexcept { return lhs.m_id <=> rhs.m_id; }
+
+private:
+    friend class StringInterner;
+
+    struct Entry {
+        String text;
+        std::size_t hash;
+    };
+
+    Atom(const Entry* entry, std::uint32_t id) noexcept : m_entry{entry}, m_id{id} {}
+
+    const Entry* m_entry{nullptr};
+    // 0 is the default-constructed Atom; interned strings are numbered from 1.
+    std::uint32_t m_id{0};
+};
+
+template<>
+struct std::hash<Atom> {
+    std::size_t operator()(const Atom& atom) const noexcept { return atom.hash(); }
+};
+
+// A thread-safe string pool handing out Atoms. Lookups take a shared lock on one of Shards
+// independently locked shards, picked by the string's hash, so readers of different strings rarely
+// contend and readers of the same string never block each other.
+class StringInterner {
+public:
+    static constexpr std::size_t Shards{32};
+
+    StringInterner() = default;
+    StringInterner(const StringInterner&) = delete;
+    StringInterner& operator=(const StringInterner&) = delete;
+
+    // Returns the Atom for text, adding text to the pool on first use.
+    Atom intern(std::string_view text) {
+        std::size_t hash = hash_of(text);
+        Shard& shard = shard_for(hash);
+        Key key{text, hash};
+        {
+            std::shared_lock lock{shard.mutex};
+            if (auto it = shard.atoms.find(key); it != shard.atoms.end()) {
+                return it->second;
+            }
+        }
+
+        std::unique_lock lock{shard.mutex};
+        if (auto it = shard.atoms.find(key); it != shard.atoms.end()) {
+            return it->second;
+        }
+        std::uint64_t id = m_next_id.fetch_add(1, std::memory_order_relaxed);
+        if (id > std::numeric_limits<std::uint32_t>::max()) {
+            throw std::length_error{"StringInterner: ran out of 32-bit atom ids"};
+        }
+        const Atom::Entry& entry = shard.entries.emplace_back(Atom::Entry{String{text}, hash});
+        Atom atom{&entry, static_cast<std::uint32_t>(id)};
+        shard.atoms.emplace(Key{{entry.text.data(), entry.text.size()}, hash}, atom);
+        return atom;
+    }
+
+    Atom intern(const String& text) { return intern(std::string_view{text.data(), text.size()}); }
+    Atom intern(const char* text) { return intern(std::string_view{text}); }
+
+    // Returns the Atom for text if it has been interned, without adding it.
+    [[nodiscard]] std::optional<Atom> find(std::string_view text) const {
+        std::size_t hash = hash_of(text);
+        const Shard& shard = shard_for(hash);
+        std::shared_lock lock{shard.mutex};
+        if (auto it = shard.atoms.find(Key{text, hash}); it != shard.atoms.end()) {
+            return it->second;
+        }
+        return std::nullopt;
+    }
+
+    [[nodiscard]] std::size_t size() const {
+        std::size_t total = 0;
+        for (const Shard& shard: m_shards) {
+            std::shared_lock lock{shard.mutex};
+            total += shard.atoms.size();
+        }
+        return total;
+    }
+
+private:
+    struct Key {
+        std::string_view text;
+        std::size_t hash;
+
+        bool operator==(const Key& other) const noexcept { return hash == other.hash && text == other.text; }
+    };
+
+    struct KeyHash {
+        std::size_t operator()(const Key& key) const noexcept { return key.hash; }
+    };
+
+    // Each shard sits on its own cache lines so that locking one does not invalidate its neighbours.
+    struct alignas(64) Shard {
+        mutable std::shared_mutex mutex;
+        std::unordered_map<Key, Atom, KeyHash> atoms;
+        // A deque never moves its elements, so Atoms can point into it.
+        std::deque<Atom::Entry> entries;
+    };
+
+    std::array<Shard, Shards> m_shards;
+    std::atomic<std::uint64_t> m_next_id{1};
+
+    static std::size_t hash_of(std::string_view text) noexcept { return StringHash{}(text); }
+
+    // The top bits pick the shard; the unordered_map uses the low bits for its buckets.
+    static std::size_t shard_index(std::size_t hash) noexcept { return (hash >> (4 * sizeof(std::size_t))) % Shards; }
+    Shard& shard_for(std::size_t hash) noexcept { return m_shards[shard_index(hash)]; }
+    const Shard& shard_for(std::size_t hash) const noexcept { return m_shards[shard_index(hash)]; }
+};
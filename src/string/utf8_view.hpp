@@ -0,0 +1,111 @@
+#pragma once
+
+#include <cstddef>
+#include <iterator>
+#include <ranges>
+#include <string_view>
+
+// A lazy range over the code points of a UTF-8 string. Each malformed or truncated sequence
+// decodes to one U+FFFD and iteration resumes at the next byte, so any byte string can be walked;
+// run simdValidateUtf8 first when malformed input should be rejected instead.
+class Utf8View : public std::ranges::view_interface<Utf8View> {
+public:
+    static constexpr char32_t REPLACEMENT{0xFFFD};
+
+    class iterator {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = char32_t;
+        using difference_type = std::ptrdiff_t;
+
+        iterator() = default;
+
+        char32_t operator*() const noexcept { return m_cp; }
+
+        iterator& operator++() noexcept {
+            m_pos += m_len;
+            decode();
+            return *this;
+        }
+
+        iterator operator++(int) noexcept {
+            iterator tmp{*this};
+            ++*this;
+            return tmp;
+        }
+
+        // Byte offset of the current code point in the string.
+        [[nodiscard]] std::size_t offset() const noexcept { return m_pos; }
+
+        friend bool operator==(const iterator& a, const iterator& b) noexcept { return a.m_pos == b.m_pos; }
+        friend bool operator==(const iterator& it, std::default_sentinel_t) noexcept {
+            return it.m_pos >= it.m_str.size();
+        }
+
+    private:
+        friend class Utf8View;
+
+        explicit iterator(std::string_view str) noexcept : m_str{str} { decode(); }
+
+        std::string_view m_str;
+        std::size_t m_pos{0};
+        std::size_t m_len{0};
+        char32_t m_cp{0};
+
+        void decode() noexcept {
+            if (m_pos >= m_str.size()) {
+                return;
+            }
+            const auto* p = reinterpret_cast<const unsigned char*>(m_str.data()) + m_pos;
+            std::size_t left = m_str.size() - m_pos;
+            unsigned char c = p[0];
+            m_len = 1;
+            m_cp = c;
+            if (c < 0x80) {
+                return;
+            }
+            m_cp = REPLACEMENT;
+            std::size_t len;
+            char32_t cp;
+            unsigned char lo = 0x80;
+            unsigned char hi = 0xBF;
+            if (c >= 0xC2 && c <= 0xDF) {
+                len = 2;
+                cp = c & 0x1F;
+            } else if (c >= 0xE0 && c <= 0xEF) {
+                len = 3;
+                cp = c & 0x0F;
+                lo = c == 0xE0 ? 0xA0 : 0x80;
+                hi = c == 0xED ? 0x9F : 0xBF;
+            } else if (c >= 0xF0 && c <= 0xF4) {
+                len = 4;
+                cp = c & 0x07;
+                lo = c == 0xF0 ? 0x90 : 0x80;
+                hi = c == 0xF4 ? 0x8F : 0xBF;
+            } else {
+                return;
+            }
+            if (left < len || p[1] < lo || p[1] > hi) {
+                return;
+            }
+            for (std::size_t k = 1; k < len; ++k) {
+                if ((p[k] & 0xC0) != 0x80) {
+                    return;
+                }
+                cp = (cp << 6) | (p[k] & 0x3F);
+            }
+            m_cp = cp;
+            m_len = len;
+        }
+    };
+
+    Utf8View() = default;
+
+    explicit Utf8View(std::string_view str) noexcept : m_str{str} {}
+
+    [[nodiscard]] iterator begin() const noexcept { return iterator{m_str}; }
+    [[nodiscard]] std::default_sentinel_t end() const noexcept { return std::default_sentinel; }
+
+private:
+    std::string_view m_str;
+};
@@ -0,0 +1,78 @@
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <concepts>
+#include <cstddef>
+
+// A growth policy picks the next capacity when a container runs out of room. It receives the
+// current capacity, the capacity that is required right now and the element size in bytes, and
+// must return at least the required capacity.
+template<typename P>
+concept GrowthPolicy = requires(std::size_t n) {
+    { P::nextCapacity(n, n, n) } -> std::convertible_to<std::size_t>;
+};
+
+// Doubles the capacity, starting at 4 elements.
+struct GrowDouble {
+    static constexpr std::size_t nextCapacity(std::size_t cap, std::size_t required, std::size_t) noexcept {
+        return std::max(cap == 0 ? std::size_t{4} : cap * 2, required);
+    }
+};
+
+// Grows by 1.5x. Wastes at most a third of the buffer, and after a few steps the blocks freed
+// by earlier growth add up to enough room for the next one, so the allocator can reuse them.
+struct GrowOneAndHalf {
+    static constexpr std::size_t nextCapacity(std::size_t cap, std::size_t required, std::size_t) noexcept {
+        return std::max(cap < 4 ? std::size_t{4} : cap + cap / 2, required);
+    }
+};
+
+// Grows by 1.5x and then rounds the byte size up to the allocator size class that would serve it
+// (16-byte steps up to 128 bytes, four classes per power of two above that, whole pages past
+// 64 KiB), so the slack the allocator hands out anyway becomes usable capacity.
+struct GrowSizeClass {
+    static constexpr std::size_t pageSize = 4096;
+
+    static constexpr std::size_t roundToSizeClass(std::size_t bytes) noexcept {
+        if (bytes <= 128) {
+            return std::max<std::size_t>((bytes + 15) & ~std::size_t{15}, 16);
+        }
+        if (bytes > 64 * 1024) {
+            return (bytes + pageSize - 1) & ~(pageSize - 1);
+        }
+        std::size_t spacing = std::bit_floor(bytes - 1) / 4;
+        return (bytes + spacing - 1) & ~(spacing - 1);
+    }
+
+    static constexpr std::size_t nextCapacity(std::size_t cap, std::size_t required, std::size_t elemSize) noexcept {
+        std::size_t wanted = std::max(GrowOneAndHalf::nextCapacity(cap, required, elemSize), required);
+        return std::max(roundToSizeClass(wanted * elemSize) / elemSize, wanted);
+    }
+};
+
+// Stats type that records nothing; Vector's default.
+struct NoVectorStats {
+    constexpr void onAllocate(std::size_t) noexcept {}
+    constexpr void onReallocate(std::size_t, std::size_t) noexcept {}
+
+    constexpr auto operator<=>(const NoVectorStats&) const noexcept = default;
+};
+
+// Counts the reallocations of a Vector, the bytes it relocated into new buffers (zero for buffers
+// the allocator resized in place) and the largest capacity it reached.
+struct VectorStats {
+    std::size_t reallocations{0};
+    std::size_t bytesCopied{0};
+    std::size_t peakCapacity{0};
+
+    constexpr void onAllocate(std::size_t cap) noexcept { peakCapacity = std::max(peakCapacity, cap); }
+
+    constexpr void onReallocate(std::size_t newCap, std::size_t bytes) noexcept {
+        ++reallocations;
+        bytesCopied += bytes;
+        onAllocate(newCap);
+    }
+
+    constexpr auto operator<=>(const VectorStats&) const noexcept = default;
+};
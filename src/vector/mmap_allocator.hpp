@@ -0,0 +1,131 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+
+#if defined(__linux__)
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+// Allocator for very large buffers of trivially relocatable elements. Blocks below Threshold bytes
+// come from malloc/realloc; larger blocks are anonymous mappings, so growing them with mremap lets
+// the kernel move page table entries instead of copying the bytes. On platforms without mremap
+// every block is served by malloc/realloc.
+template<typename T, std::size_t Threshold = (std::size_t{1} << 20)>
+class MmapAllocator {
+public:
+    using value_type = T;
+
+    template<typename U>
+    struct rebind {
+        using other = MmapAllocator<U, Threshold>;
+    };
+
+    static_assert(alignof(T) <= alignof(std::max_align_t), "MmapAllocator does not support over-aligned types");
+
+    constexpr MmapAllocator() noexcept = default;
+
+    template<typename U>
+    constexpr MmapAllocator(const MmapAllocator<U, Threshold>&) noexcept {}
+
+    [[nodiscard]] T* allocate(std::size_t count) {
+        if (count > maxCount()) {
+            throw std::bad_array_new_length{};
+        }
+        std::size_t bytes = count * sizeof(T);
+        if (isMapped(bytes)) {
+            return static_cast<T*>(mapPages(bytes));
+        }
+        void* ptr = std::malloc(std::max<std::size_t>(bytes, 1));
+        if (!ptr) {
+            throw std::bad_alloc{};
+        }
+        return static_cast<T*>(ptr);
+    }
+
+    void deallocate(T* ptr, std::size_t count) noexcept {
+        if (!ptr) {
+            return;
+        }
+        std::size_t bytes = count * sizeof(T);
+#if defined(__linux__)
+        if (isMapped(bytes)) {
+            ::munmap(ptr, roundToPage(bytes));
+            return;
+        }
+#endif
+        (void) bytes;
+        std::free(ptr);
+    }
+
+    // Resizes the block at ptr from oldCount to newCount elements, preserving the first
+    // min(oldCount, newCount) elements bytewise. Returns the (possibly moved) block.
+    [[nodiscard]] T* reallocate(T* ptr, std::size_t oldCount, std::size_t newCount) {
+        if (!ptr) {
+            return newCount ? allocate(newCount) : nullptr;
+        }
+        if (newCount == 0) {
+            deallocate(ptr, oldCount);
+            return nullptr;
+        }
+        if (newCount > maxCount()) {
+            throw std::bad_array_new_length{};
+        }
+
+        std::size_t oldBytes = oldCount * sizeof(T);
+        std::size_t newBytes = newCount * sizeof(T);
+        bool oldMapped = isMapped(oldBytes);
+        bool newMapped = isMapped(newBytes);
+
+#if defined(__linux__)
+        if (oldMapped && newMapped) {
+            void* moved = ::mremap(ptr, roundToPage(oldBytes), roundToPage(newBytes), MREMAP_MAYMOVE);
+            if (moved == MAP_FAILED) {
+                throw std::bad_alloc{};
+            }
+            return static_cast<T*>(moved);
+        }
+#endif
+        if (!oldMapped && !newMapped) {
+            void* moved = std::realloc(ptr, newBytes);
+            if (!moved) {
+                throw std::bad_alloc{};
+            }
+            return static_cast<T*>(moved);
+        }
+
+        T* newPtr = allocate(newCount);
+        std::memcpy(static_cast<void*>(newPtr), static_cast<const void*>(ptr), std::min(oldBytes, newBytes));
+        deallocate(ptr, oldCount);
+        return newPtr;
+    }
+
+    friend constexpr bool operator==(const MmapAllocator&, const MmapAllocator&) noexcept { return true; }
+
+private:
+    static constexpr std::size_t maxCount() noexcept { return static_cast<std::size_t>(-1) / 2 / sizeof(T); }
+
+#if defined(__linux__)
+    static bool isMapped(std::size_t bytes) noexcept { return bytes >= Threshold; }
+
+    static std::size_t roundToPage(std::size_t bytes) noexcept {
+        static const std::size_t pageSize = static_cast<std::size_t>(::sysconf(_SC_PAGESIZE));
+        return (bytes + pageSize - 1) & ~(pageSize - 1);
+    }
+
+    static void* mapPages(std::size_t bytes) {
+        void* ptr = ::mmap(nullptr, roundToPage(bytes), PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (ptr == MAP_FAILED) {
+            throw std::bad_alloc{};
+        }
+        return ptr;
+    }
+#else
+    static constexpr bool isMapped(std::size_t) noexcept { return false; }
+    static void* mapPages(std::size_t) { return nullptr; }
+#endif
+};
@@ -0,0 +1,299 @@
+#pragma once
+
+#include <algorithm>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <ranges>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <type_traits>
+#include <utility>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "growth_policy.hpp"
+
+// A Vector of trivially copyable records stored in a memory-mapped file. The file starts with a
+// small header (magic, element size, element count) followed by the elements, so opening an
+// existing file maps it in O(1) without reading or converting anything. Growing the vector
+// extends the file with ftruncate and remaps it.
+template<typename T, GrowthPolicy Growth = GrowDouble>
+class MappedVector {
+    static_assert(std::is_trivially_copyable_v<T>, "MappedVector stores raw bytes and needs trivially copyable T");
+    static_assert(alignof(T) <= 64, "MappedVector aligns elements to 64 bytes at most");
+
+public:
+    using iterator = T*;
+    using const_iterator = const T*;
+
+    static constexpr std::uint64_t magic = 0x3156454350414d44; // "DMAPVEC1"
+
+    struct Header {
+        std::uint64_t magic;
+        std::uint64_t elemSize;
+        std::uint64_t count;
+    };
+
+    static constexpr std::size_t headerSize = 64;
+    static_assert(sizeof(Header) <= headerSize);
+
+    enum class Access { Normal, Sequential, Random, WillNeed, DontNeed };
+
+    // Opens path, creating an empty vector file if it does not exist. Throws std::system_error on
+    // I/O failures and std::runtime_error if the file was not written by a MappedVector<T>.
+    explicit MappedVector(const std::filesystem::path& path) {
+        m_fd = ::open(path.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+        if (m_fd < 0) {
+            throwErrno("open");
+        }
+
+        struct stat st{};
+        if (::fstat(m_fd, &st) != 0) {
+            closeOnError("fstat");
+        }
+
+        std::size_t fileSize = static_cast<std::size_t>(st.st_size);
+        if (fileSize == 0) {
+            resizeFile(headerSize);
+            mapFile(headerSize);
+            *header() = Header{magic, sizeof(T), 0};
+            return;
+        }
+
+        if (fileSize < headerSize) {
+            ::close(m_fd);
+            throw std::runtime_error{"MappedVector: file is too small to hold a header"};
+        }
+        mapFile(fileSize);
+        if (header()->magic != magic || header()->elemSize != sizeof(T) || header()->count > capacity()) {
+            ::munmap(m_map, m_mapSize);
+            ::close(m_fd);
+            throw std::runtime_error{"MappedVector: file header does not match this element type"};
+        }
+    }
+
+    MappedVector(const MappedVector&) = delete;
+    MappedVector& operator=(const MappedVector&) = delete;
+
+    MappedVector(MappedVector&& other) noexcept :
+        m_fd{std::exchange(other.m_fd, -1)}, m_map{std::exchange(other.m_map, nullptr)},
+        m_mapSize{std::exchange(other.m_mapSize, 0)} {}
+
+    MappedVector& operator=(MappedVector&& other) noexcept {
+        if (this != &other) {
+            release();
+            m_fd = std::exchange(other.m_fd, -1);
+            m_map = std::exchange(other.m_map, nullptr);
+            m_mapSize = std::exchange(other.m_mapSize, 0);
+        }
+        return *this;
+    }
+
+    ~MappedVector() { release(); }
+
+    [[nodiscard]] T& operator[](std::size_t idx) { return data()[idx]; }
+    [[nodiscard]] const T& operator[](std::size_t idx) const { return data()[idx]; }
+
+    T& at(std::size_t idx) {
+        if (idx >= size())
+            throw std::out_of_range{"Index out of range"};
+        return data()[idx];
+    }
+
+    const T& at(std::size_t idx) const {
+        if (idx >= size())
+            throw std::out_of_range{"Index out of range"};
+        return data()[idx];
+    }
+
+    [[nodiscard]] T& front() { return data()[0]; }
+    [[nodiscard]] const T& front() const { return data()[0]; }
+    [[nodiscard]] T& back() { return data()[size() - 1]; }
+    [[nodiscard]] const T& back() const { return data()[size() - 1]; }
+    // A moved-from vector has no mapping: it is empty, with no capacity and null data().
+    [[nodiscard]] T* data() noexcept { return m_map ? reinterpret_cast<T*>(m_map + headerSize) : nullptr; }
+    [[nodiscard]] const T* data() const noexcept {
+        return m_map ? reinterpret_cast<const T*>(m_map + headerSize) : nullptr;
+    }
+    [[nodiscard]] std::size_t size() const noexcept { return m_map ? header()->count : 0; }
+    [[nodiscard]] std::size_t capacity() const noexcept { return m_map ? (m_mapSize - headerSize) / sizeof(T) : 0; }
+    [[nodiscard]] bool empty() const noexcept { return size() == 0; }
+
+    void reserve(std::size_t newCap) {
+        if (newCap > capacity()) {
+            remap(newCap);
+        }
+    }
+
+    void shrinkToFit() {
+        if (size() < capacity()) {
+            remap(size());
+        }
+    }
+
+    void resize(std::size_t newSize, const T& elem = T{}) {
+        reserve(newSize);
+        if (m_map) {
+            std::fill(data() + size(), data() + std::max(newSize, size()), elem);
+            header()->count = newSize;
+        }
+    }
+
+    void clear() noexcept {
+        if (m_map) {
+            header()->count = 0;
+        }
+    }
+
+    void pushBack(const T& value) {
+        if (size() == capacity()) {
+            remap(Growth::nextCapacity(capacity(), size() + 1, sizeof(T)));
+        }
+        data()[size()] = value;
+        ++header()->count;
+    }
+
+    template<typename... Args>
+    void emplaceBack(Args&&... args) {
+        pushBack(T{std::forward<Args>(args)...});
+    }
+
+    void popBack() noexcept {
+        if (size() > 0) {
+            --header()->count;
+        }
+    }
+
+    void erase(const T& value) {
+        if (m_map) {
+            auto newEnd = std::remove(begin(), end(), value);
+            header()->count = static_cast<std::size_t>(newEnd - begin());
+        }
+    }
+
+    void assign(std::size_t count, const T& value) {
+        clear();
+        resize(count, value);
+    }
+
+    template<std::ranges::input_range R>
+    void appendRange(R&& range) {
+        if constexpr (std::ranges::sized_range<R>) {
+            std::size_t required = size() + std::ranges::size(range);
+            if (required > capacity()) {
+                remap(Growth::nextCapacity(capacity(), required, sizeof(T)));
+            }
+        }
+        for (auto&& elem: range) {
+            pushBack(elem);
+        }
+    }
+
+    // Hints the kernel about the upcoming access pattern over the element area.
+    void advise(Access pattern) {
+        int advice = MADV_NORMAL;
+        switch (pattern) {
+            case Access::Normal:
+                advice = MADV_NORMAL;
+                break;
+            case Access::Sequential:
+                advice = MADV_SEQUENTIAL;
+                break;
+            case Access::Random:
+                advice = MADV_RANDOM;
+                break;
+            case Access::WillNeed:
+                advice = MADV_WILLNEED;
+                break;
+            case Access::DontNeed:
+                advice = MADV_DONTNEED;
+                break;
+        }
+        if (::madvise(m_map, m_mapSize, advice) != 0) {
+            throwErrno("madvise");
+        }
+    }
+
+    // Flushes dirty pages to the file; without it they are written back whenever the kernel decides.
+    void sync() {
+        if (::msync(m_map, m_mapSize, MS_SYNC) != 0) {
+            throwErrno("msync");
+        }
+    }
+
+    [[nodiscard]] iterator begin() noexcept { return data(); }
+    [[nodiscard]] const_iterator begin() const noexcept { return data(); }
+    [[nodiscard]] iterator end() noexcept { return data() + size(); }
+    [[nodiscard]] const_iterator end() const noexcept { return data() + size(); }
+    [[nodiscard]] const_iterator cbegin() const noexcept { return data(); }
+    [[nodiscard]] const_iterator cend() const noexcept { return data() + size(); }
+
+private:
+    int m_fd{-1};
+    std::byte* m_map{nullptr};
+    std::size_t m_mapSize{0};
+
+    [[nodiscard]] Header* header() noexcept { return reinterpret_cast<Header*>(m_map); }
+    [[nodiscard]] const Header* header() const noexcept { return reinterpret_cast<const Header*>(m_map); }
+
+    [[noreturn]] static void throwErrno(const char* what) {
+        throw std::system_error{errno, std::generic_category(), std::string{"MappedVector: "} + what};
+    }
+
+    [[noreturn]] void closeOnError(const char* what) {
+        int err = errno;
+        ::close(m_fd);
+        errno = err;
+        throwErrno(what);
+    }
+
+    void resizeFile(std::size_t bytes) {
+        if (::ftruncate(m_fd, static_cast<off_t>(bytes)) != 0) {
+            closeOnError("ftruncate");
+        }
+    }
+
+    void mapFile(std::size_t bytes) {
+        void* map = ::mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, m_fd, 0);
+        if (map == MAP_FAILED) {
+            closeOnError("mmap");
+        }
+        m_map = static_cast<std::byte*>(map);
+        m_mapSize = bytes;
+    }
+
+    void remap(std::size_t newCap) {
+        std::size_t newSize = headerSize + newCap * sizeof(T);
+        if (::ftruncate(m_fd, static_cast<off_t>(newSize)) != 0) {
+            throwErrno("ftruncate");
+        }
+#if defined(__linux__)
+        void* map = ::mremap(m_map, m_mapSize, newSize, MREMAP_MAYMOVE);
+#else
+        void* map = ::mmap(nullptr, newSize, PROT_READ | PROT_WRITE, MAP_SHARED, m_fd, 0);
+        if (map != MAP_FAILED) {
+            ::munmap(m_map, m_mapSize);
+        }
+#endif
+        if (map == MAP_FAILED) {
+            throwErrno("mremap");
+        }
+        m_map = static_cast<std::byte*>(map);
+        m_mapSize = newSize;
+    }
+
+    void release() noexcept {
+        if (m_map) {
+            ::munmap(m_map, m_mapSize);
+            m_map = nullptr;
+        }
+        if (m_fd >= 0) {
+            ::close(m_fd);
+            m_fd = -1;
+        }
+    }
+};
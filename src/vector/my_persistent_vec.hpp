@@ -0,0 +1,426 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <ranges>
+#include <span>
+#include <stdexcept>
+#include <utility>
+#include "my_vec.hpp"
+
+// An immutable vector stored as a 32-way trie with a separate tail leaf, in the style of Clojure's
+// PersistentVector. Copies are O(1) snapshots that share structure. pushBack and update return a
+// new vector in O(log32 n) by copying only the path to the changed leaf. Nodes are reference
+// counted atomically, so snapshots can be handed to reader threads freely.
+//
+// Mutation copies a node only while it is shared: a vector that owns its path uniquely (an rvalue,
+// or a Transient) updates it in place. This makes batch building through a Transient cost about
+// as much as filling a Vector.
+template<typename T>
+class PersistentVector {
+    static constexpr unsigned bits = 5;
+    static constexpr std::size_t width = std::size_t{1} << bits;
+    static constexpr std::size_t mask = width - 1;
+
+    struct Node {
+        std::atomic<std::uint32_t> refs{1};
+    };
+
+    struct Inner : Node {
+        Node* children[width]{};
+    };
+
+    struct Leaf : Node {
+        std::uint32_t count{0};
+        alignas(T) std::byte storage[width * sizeof(T)];
+
+        Leaf() = default;
+        Leaf(const Leaf& other) : Node{} {
+            try {
+                for (; count < other.count; ++count) {
+                    ::new (elems() + count) T(other.elems()[count]);
+                }
+            } catch (...) {
+                std::destroy_n(elems(), count);
+                throw;
+            }
+        }
+        ~Leaf() {
+            for (std::uint32_t i = 0; i < count; ++i) {
+                elems()[i].~T();
+            }
+        }
+
+        T* elems() noexcept { return std::launder(reinterpret_cast<T*>(storage)); }
+        const T* elems() const noexcept { return std::launder(reinterpret_cast<const T*>(storage)); }
+    };
+
+public:
+    class Transient;
+
+    class const_iterator {
+    public:
+        using iterator_category = std::random_access_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const T*;
+        using reference = const T&;
+
+        const_iterator() = default;
+
+        reference operator*() const { return (*m_vec)[m_idx]; }
+        pointer operator->() const { return &(*m_vec)[m_idx]; }
+        reference operator[](difference_type n) const { return (*m_vec)[m_idx + n]; }
+
+        const_iterator& operator++() {
+            ++m_idx;
+            return *this;
+        }
+        const_iterator operator++(int) { return {m_vec, m_idx++}; }
+        const_iterator& operator--() {
+            --m_idx;
+            return *this;
+        }
+        const_iterator operator--(int) { return {m_vec, m_idx--}; }
+        const_iterator& operator+=(difference_type n) {
+            m_idx += n;
+            return *this;
+        }
+        const_iterator& operator-=(difference_type n) {
+            m_idx -= n;
+            return *this;
+        }
+        friend const_iterator operator+(const_iterator it, difference_type n) { return it += n; }
+        friend const_iterator operator+(difference_type n, const_iterator it) { return it += n; }
+        friend const_iterator operator-(const_iterator it, difference_type n) { return it -= n; }
+        friend difference_type operator-(const const_iterator& a, const const_iterator& b) {
+            return static_cast<difference_type>(a.m_idx) - static_cast<difference_type>(b.m_idx);
+        }
+        friend bool operator==(const const_iterator& a, const const_iterator& b) { return a.m_idx == b.m_idx; }
+        friend auto operator<=>(const const_iterator& a, const const_iterator& b) { return a.m_idx <=> b.m_idx; }
+
+    private:
+        friend class PersistentVector;
+        const_iterator(const PersistentVector* vec, std::size_t idx) : m_vec{vec}, m_idx{idx} {}
+
+        const PersistentVector* m_vec{nullptr};
+        std::size_t m_idx{0};
+    };
+
+    using iterator = const_iterator;
+
+    PersistentVector() noexcept = default;
+
+    PersistentVector(std::initializer_list<T> init) { appendAll(init); }
+
+    template<typename A, typename G, typename S>
+    explicit PersistentVector(const Vector<T, A, G, S>& vec) {
+        appendAll(vec);
+    }
+
+    PersistentVector(const PersistentVector& other) noexcept :
+        m_root{other.m_root}, m_tail{other.m_tail}, m_size{other.m_size}, m_shift{other.m_shift} {
+        retain(m_root);
+        retain(m_tail);
+    }
+
+    PersistentVector(PersistentVector&& other) noexcept :
+        m_root{std::exchange(other.m_root, nullptr)}, m_tail{std::exchange(other.m_tail, nullptr)},
+        m_size{std::exchange(other.m_size, 0)}, m_shift{std::exchange(other.m_shift, bits)} {}
+
+    PersistentVector& operator=(PersistentVector other) noexcept {
+        swap(*this, other);
+        return *this;
+    }
+
+    ~PersistentVector() {
+        release(m_root, m_shift);
+        release(m_tail, 0);
+    }
+
+    friend bool operator==(const PersistentVector& lhs, const PersistentVector& rhs) {
+        if (lhs.m_size != rhs.m_size) {
+            return false;
+        }
+        if (lhs.m_root == rhs.m_root && lhs.m_tail == rhs.m_tail) {
+            return true;
+        }
+        for (std::size_t i = 0; i < lhs.m_size; ++i) {
+            if (!(lhs[i] == rhs[i])) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    [[nodiscard]] const T& operator[](std::size_t idx) const { return leafFor(idx)->elems()[idx & mask]; }
+
+    const T& at(std::size_t idx) const {
+        if (idx >= m_size)
+            throw std::out_of_range{"Index out of range"};
+        return (*this)[idx];
+    }
+
+    [[nodiscard]] const T& front() const { return (*this)[0]; }
+    [[nodiscard]] const T& back() const { return (*this)[m_size - 1]; }
+    [[nodiscard]] std::size_t size() const noexcept { return m_size; }
+    [[nodiscard]] bool empty() const noexcept { return m_size == 0; }
+
+    // Returns a copy with value appended. Called on an rvalue, the vector's own nodes are reused.
+    [[nodiscard]] PersistentVector pushBack(const T& value) const& {
+        PersistentVector result{*this};
+        result.mutPushBack(value);
+        return result;
+    }
+
+    [[nodiscard]] PersistentVector pushBack(const T& value) && {
+        mutPushBack(value);
+        return std::move(*this);
+    }
+
+    // Returns a copy with the element at idx replaced by value.
+    [[nodiscard]] PersistentVector update(std::size_t idx, const T& value) const& {
+        PersistentVector result{*this};
+        result.mutUpdate(idx, value);
+        return result;
+    }
+
+    [[nodiscard]] PersistentVector update(std::size_t idx, const T& value) && {
+        mutUpdate(idx, value);
+        return std::move(*this);
+    }
+
+    // Starts a batch of in-place edits. Nodes shared with other snapshots are copied once, on their
+    // first modification.
+    [[nodiscard]] Transient transient() const& { return Transient{*this}; }
+    [[nodiscard]] Transient transient() && { return Transient{std::move(*this)}; }
+
+    // Calls fn with each leaf as a contiguous span, in order.
+    template<typename Fn>
+    void forEachChunk(Fn&& fn) const {
+        std::size_t tailStart = tailOffset();
+        for (std::size_t i = 0; i < tailStart; i += width) {
+            const Leaf* leaf = leafFor(i);
+            fn(std::span<const T>{leaf->elems(), leaf->count});
+        }
+        if (m_tail) {
+            fn(std::span<const T>{m_tail->elems(), m_tail->count});
+        }
+    }
+
+    [[nodiscard]] Vector<T> toVector() const {
+        Vector<T> result;
+        result.reserve(m_size);
+        forEachChunk([&](std::span<const T> chunk) { result.appendRange(chunk); });
+        return result;
+    }
+
+    [[nodiscard]] const_iterator begin() const noexcept { return {this, 0}; }
+    [[nodiscard]] const_iterator end() const noexcept { return {this, m_size}; }
+    [[nodiscard]] const_iterator cbegin() const noexcept { return begin(); }
+    [[nodiscard]] const_iterator cend() const noexcept { return end(); }
+
+    friend void swap(PersistentVector& first, PersistentVector& second) noexcept {
+        using std::swap;
+        swap(first.m_root, second.m_root);
+        swap(first.m_tail, second.m_tail);
+        swap(first.m_size, second.m_size);
+        swap(first.m_shift, second.m_shift);
+    }
+
+private:
+    Inner* m_root{nullptr};
+    Leaf* m_tail{nullptr};
+    std::size_t m_size{0};
+    unsigned m_shift{bits};
+
+    static void retain(Node* node) noexcept {
+        if (node) {
+            node->refs.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    // Drops one reference to node, which sits `level` bits above the leaves (0 for a leaf).
+    static void release(Node* node, unsigned level) noexcept {
+        if (!node || node->refs.fetch_sub(1, std::memory_order_acq_rel) != 1) {
+            return;
+        }
+        if (level == 0) {
+            delete static_cast<Leaf*>(node);
+            return;
+        }
+        Inner* inner = static_cast<Inner*>(node);
+        for (Node* child: inner->children) {
+            release(child, level - bits);
+        }
+        delete inner;
+    }
+
+    static bool isUnique(const Node* node) noexcept { return node->refs.load(std::memory_order_acquire) == 1; }
+
+    // Returns a node that may be modified in place in place of node, which sits `level` bits above
+    // the leaves and which the caller holds one reference to. Shared nodes are copied and the
+    // caller's reference moves to the copy; it is dropped through release(), since the other owners
+    // may have let go since isUnique() was checked.
+    static Inner* editable(Inner* node, unsigned level) {
+        if (!node) {
+            return new Inner;
+        }
+        if (isUnique(node)) {
+            return node;
+        }
+        Inner* copy = new Inner;
+        for (std::size_t i = 0; i < width; ++i) {
+            copy->children[i] = node->children[i];
+            retain(copy->children[i]);
+        }
+        release(node, level);
+        return copy;
+    }
+
+    static Leaf* editable(Leaf* leaf) {
+        if (!leaf) {
+            return new Leaf;
+        }
+        if (isUnique(leaf)) {
+            return leaf;
+        }
+        Leaf* copy = new Leaf{*leaf};
+        release(leaf, 0);
+        return copy;
+    }
+
+    [[nodiscard]] std::size_t tailOffset() const noexcept { return m_size < width ? 0 : ((m_size - 1) >> bits) << bits; }
+
+    [[nodiscard]] const Leaf* leafFor(std::size_t idx) const noexcept {
+        if (idx >= tailOffset()) {
+            return m_tail;
+        }
+        const Node* node = m_root;
+        for (unsigned level = m_shift; level > 0; level -= bits) {
+            node = static_cast<const Inner*>(node)->children[(idx >> level) & mask];
+        }
+        return static_cast<const Leaf*>(node);
+    }
+
+    template<typename R>
+    void appendAll(const R& range) {
+        for (const auto& value: range) {
+            mutPushBack(value);
+        }
+    }
+
+    void mutPushBack(const T& value) {
+        if (m_size - tailOffset() < width) {
+            Leaf* tail = editable(m_tail);
+            m_tail = tail;
+            ::new (tail->elems() + tail->count) T(value);
+            ++tail->count;
+            ++m_size;
+            return;
+        }
+
+        Leaf* newTail = new Leaf;
+        try {
+            ::new (newTail->elems()) T(value);
+        } catch (...) {
+            delete newTail;
+            throw;
+        }
+        newTail->count = 1;
+
+        Leaf* full = m_tail;
+        if ((m_size >> bits) > (std::size_t{1} << m_shift)) {
+            Inner* newRoot = new Inner;
+            newRoot->children[0] = m_root;
+            newRoot->children[1] = newPath(m_shift, full);
+            m_root = newRoot;
+            m_shift += bits;
+        } else {
+            m_root = pushTail(m_shift, m_root, full);
+        }
+        m_tail = newTail;
+        ++m_size;
+    }
+
+    Inner* pushTail(unsigned level, Inner* parent, Leaf* tail) {
+        Inner* node = editable(parent, level);
+        std::size_t sub = ((m_size - 1) >> level) & mask;
+        if (level == bits) {
+            node->children[sub] = tail;
+        } else {
+            node->children[sub] = pushTail(level - bits, static_cast<Inner*>(node->children[sub]), tail);
+        }
+        return node;
+    }
+
+    static Node* newPath(unsigned level, Leaf* leaf) {
+        if (level == 0) {
+            return leaf;
+        }
+        Inner* node = new Inner;
+        node->children[0] = newPath(level - bits, leaf);
+        return node;
+    }
+
+    void mutUpdate(std::size_t idx, const T& value) {
+        if (idx >= m_size) {
+            throw std::out_of_range{"Index out of range"};
+        }
+        if (idx >= tailOffset()) {
+            m_tail = editable(m_tail);
+            m_tail->elems()[idx & mask] = value;
+            return;
+        }
+
+        m_root = editable(m_root, m_shift);
+        Inner* node = m_root;
+        for (unsigned level = m_shift; level > bits; level -= bits) {
+            Node*& child = node->children[(idx >> level) & mask];
+            child = editable(static_cast<Inner*>(child), level - bits);
+            node = static_cast<Inner*>(child);
+        }
+        Node*& leafSlot = node->children[(idx >> bits) & mask];
+        Leaf* leaf = editable(static_cast<Leaf*>(leafSlot));
+        leafSlot = leaf;
+        leaf->elems()[idx & mask] = value;
+    }
+
+public:
+    // A mutable view of a PersistentVector for batch edits. persistent() turns it back into an
+    // immutable vector in O(1).
+    class Transient {
+    public:
+        explicit Transient(PersistentVector vec) noexcept : m_vec{std::move(vec)} {}
+
+        Transient& pushBack(const T& value) {
+            m_vec.mutPushBack(value);
+            return *this;
+        }
+
+        Transient& update(std::size_t idx, const T& value) {
+            m_vec.mutUpdate(idx, value);
+            return *this;
+        }
+
+        template<std::ranges::input_range R>
+        Transient& appendRange(R&& range) {
+            m_vec.appendAll(range);
+            return *this;
+        }
+
+        [[nodiscard]] const T& operator[](std::size_t idx) const { return m_vec[idx]; }
+        [[nodiscard]] std::size_t size() const noexcept { return m_vec.size(); }
+        [[nodiscard]] bool empty() const noexcept { return m_vec.empty(); }
+
+        [[nodiscard]] PersistentVector persistent() && noexcept { return std::move(m_vec); }
+
+    private:
+        PersistentVector m_vec;
+    };
+};
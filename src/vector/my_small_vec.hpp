@@ -0,0 +1,290 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <ranges>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include "relocate.hpp"
+
+// A Vector that keeps its first N elements in inline storage and only allocates once it outgrows
+// them. Moving a spilled SmallVector steals the heap buffer; moving an inline one relocates the
+// elements.
+template<typename T, std::size_t N, typename Alloc = std::allocator<T>>
+class SmallVector {
+    static_assert(N > 0, "SmallVector needs at least one inline element; use Vector instead");
+
+public:
+    using iterator = T*;
+    using const_iterator = const T*;
+
+    SmallVector() noexcept : m_data{inlineData()}, m_size{0}, m_cap{N} {}
+
+    SmallVector(std::size_t count, const T& elem = T{}) : SmallVector() {
+        reserve(count);
+        std::uninitialized_fill_n(m_data, count, elem);
+        m_size = count;
+    }
+
+    SmallVector(std::initializer_list<T> init) : SmallVector() { assign(init.begin(), init.end()); }
+
+    SmallVector(const SmallVector& other) : SmallVector() { assign(other.begin(), other.end()); }
+
+    SmallVector(SmallVector&& other) noexcept(std::is_nothrow_move_constructible_v<T>) : SmallVector() {
+        stealFrom(other);
+    }
+
+#if defined(__cpp_lib_containers_ranges)
+    template<std::ranges::input_range R>
+    SmallVector(std::from_range_t, R&& range) : SmallVector() {
+        appendRange(std::forward<R>(range));
+    }
+#endif
+
+    SmallVector& operator=(const SmallVector& other) {
+        if (this != &other) {
+            assign(other.begin(), other.end());
+        }
+        return *this;
+    }
+
+    SmallVector& operator=(SmallVector&& other) noexcept(std::is_nothrow_move_constructible_v<T>) {
+        if (this != &other) {
+            clear();
+            releaseHeap();
+            stealFrom(other);
+        }
+        return *this;
+    }
+
+    ~SmallVector() {
+        clear();
+        releaseHeap();
+    }
+
+    friend bool operator==(const SmallVector& lhs, const SmallVector& rhs) {
+        return std::equal(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+    }
+
+    friend auto operator<=>(const SmallVector& lhs, const SmallVector& rhs) {
+        return std::lexicographical_compare_three_way(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+    }
+
+    [[nodiscard]] constexpr T& operator[](std::size_t idx) { return m_data[idx]; }
+    [[nodiscard]] constexpr const T& operator[](std::size_t idx) const { return m_data[idx]; }
+
+    constexpr T& at(std::size_t idx) {
+        if (idx >= m_size)
+            throw std::out_of_range{"Index out of range"};
+        return m_data[idx];
+    }
+
+    constexpr const T& at(std::size_t idx) const {
+        if (idx >= m_size)
+            throw std::out_of_range{"Index out of range"};
+        return m_data[idx];
+    }
+
+    [[nodiscard]] constexpr T& front() { return m_data[0]; }
+    [[nodiscard]] constexpr const T& front() const { return m_data[0]; }
+    [[nodiscard]] constexpr T& back() { return m_data[m_size - 1]; }
+    [[nodiscard]] constexpr const T& back() const { return m_data[m_size - 1]; }
+    [[nodiscard]] constexpr T* data() noexcept { return m_data; }
+    [[nodiscard]] constexpr const T* data() const noexcept { return m_data; }
+    [[nodiscard]] constexpr std::size_t size() const noexcept { return m_size; }
+    [[nodiscard]] constexpr std::size_t capacity() const noexcept { return m_cap; }
+    [[nodiscard]] constexpr bool empty() const noexcept { return m_size == 0; }
+    [[nodiscard]] static constexpr std::size_t inlineCapacity() noexcept { return N; }
+    [[nodiscard]] bool isInline() const noexcept { return m_data == inlineData(); }
+
+    void reserve(std::size_t newCap) {
+        if (newCap > m_cap) {
+            reallocate(newCap);
+        }
+    }
+
+    // Releases unused heap capacity, moving the elements back inline when they fit.
+    void shrinkToFit() {
+        if (isInline() || m_size == m_cap) {
+            return;
+        }
+        if (m_size <= N) {
+            T* heap = m_data;
+            std::size_t heapCap = m_cap;
+            relocateElements(inlineData(), heap, m_size);
+            m_allocator.deallocate(heap, heapCap);
+            m_data = inlineData();
+            m_cap = N;
+        } else {
+            reallocate(m_size);
+        }
+    }
+
+    void resize(std::size_t newSize, const T& elem = T{}) {
+        if (newSize < m_size) {
+            std::destroy(m_data + newSize, m_data + m_size);
+        } else if (newSize > m_size) {
+            reserve(newSize);
+            std::uninitialized_fill(m_data + m_size, m_data + newSize, elem);
+        }
+        m_size = newSize;
+    }
+
+    void clear() noexcept {
+        std::destroy_n(m_data, m_size);
+        m_size = 0;
+    }
+
+    void pushBack(const T& value) { emplaceBack(value); }
+
+    void pushBack(T&& value) { emplaceBack(std::move(value)); }
+
+    template<typename... Args>
+    void emplaceBack(Args&&... args) {
+        if (m_size == m_cap) {
+            reallocate(m_cap * 2);
+        }
+        ::new (m_data + m_size) T{std::forward<Args>(args)...};
+        ++m_size;
+    }
+
+    constexpr void popBack() {
+        if (m_size > 0) {
+            m_data[m_size - 1].~T();
+            --m_size;
+        }
+    }
+
+    void erase(const T& value) {
+        auto newEnd = std::remove(begin(), end(), value);
+        std::destroy(newEnd, end());
+        m_size = static_cast<std::size_t>(newEnd - begin());
+    }
+
+    iterator erase(const_iterator pos) { return erase(pos, pos + 1); }
+
+    iterator erase(const_iterator first, const_iterator last) {
+        iterator dst = begin() + (first - cbegin());
+        iterator newEnd = std::move(begin() + (last - cbegin()), end(), dst);
+        std::destroy(newEnd, end());
+        m_size = static_cast<std::size_t>(newEnd - begin());
+        return dst;
+    }
+
+    void assign(std::size_t count, const T& value) {
+        clear();
+        reserve(count);
+        std::uninitialized_fill_n(m_data, count, value);
+        m_size = count;
+    }
+
+    template<std::input_iterator InputIt, std::sentinel_for<InputIt> Sent>
+    void assign(InputIt first, Sent last) {
+        clear();
+        insert(begin(), first, last);
+    }
+
+    void assign(std::initializer_list<T> init) { assign(init.begin(), init.end()); }
+
+    template<std::input_iterator InputIt, std::sentinel_for<InputIt> Sent>
+    iterator insert(const_iterator pos, InputIt first, Sent last) {
+        std::size_t idx = static_cast<std::size_t>(pos - m_data);
+        std::size_t oldSize = m_size;
+
+        if constexpr (std::forward_iterator<InputIt>) {
+            std::size_t count = static_cast<std::size_t>(std::ranges::distance(first, last));
+            if (m_size + count > m_cap) {
+                reallocate(std::max(m_size + count, m_cap * 2));
+            }
+            std::uninitialized_copy_n(first, count, m_data + m_size);
+            m_size += count;
+        } else {
+            for (; first != last; ++first) {
+                emplaceBack(*first);
+            }
+        }
+
+        std::rotate(m_data + idx, m_data + oldSize, m_data + m_size);
+        return m_data + idx;
+    }
+
+    template<std::ranges::input_range R>
+    void appendRange(R&& range) {
+        if constexpr (std::is_rvalue_reference_v<R&&> && !std::ranges::view<std::remove_cvref_t<R>>) {
+            insert(end(), std::make_move_iterator(std::ranges::begin(range)),
+                   std::move_sentinel(std::ranges::end(range)));
+        } else {
+            insert(end(), std::ranges::begin(range), std::ranges::end(range));
+        }
+    }
+
+    [[nodiscard]] iterator begin() noexcept { return m_data; }
+    [[nodiscard]] const_iterator begin() const noexcept { return m_data; }
+    [[nodiscard]] iterator end() noexcept { return m_data + m_size; }
+    [[nodiscard]] const_iterator end() const noexcept { return m_data + m_size; }
+    [[nodiscard]] const_iterator cbegin() const noexcept { return m_data; }
+    [[nodiscard]] const_iterator cend() const noexcept { return m_data + m_size; }
+
+    friend void swap(SmallVector& first, SmallVector& second) noexcept(std::is_nothrow_move_constructible_v<T>) {
+        SmallVector tmp{std::move(first)};
+        first = std::move(second);
+        second = std::move(tmp);
+    }
+
+private:
+    T* m_data;
+    std::size_t m_size;
+    std::size_t m_cap;
+    [[no_unique_address]] Alloc m_allocator{};
+    alignas(T) std::byte m_inline[N * sizeof(T)];
+
+    [[nodiscard]] T* inlineData() noexcept { return reinterpret_cast<T*>(m_inline); }
+    [[nodiscard]] const T* inlineData() const noexcept { return reinterpret_cast<const T*>(m_inline); }
+
+    void releaseHeap() noexcept {
+        if (!isInline()) {
+            m_allocator.deallocate(m_data, m_cap);
+            m_data = inlineData();
+            m_cap = N;
+        }
+    }
+
+    // Takes other's elements, leaving it empty and inline. Expects *this to be empty and inline.
+    void stealFrom(SmallVector& other) {
+        if (other.isInline()) {
+            if constexpr (isTriviallyRelocatable<T>) {
+                relocateElements(m_data, other.m_data, other.m_size);
+            } else {
+                std::uninitialized_move_n(other.m_data, other.m_size, m_data);
+                std::destroy_n(other.m_data, other.m_size);
+            }
+            m_size = other.m_size;
+        } else {
+            m_data = std::exchange(other.m_data, other.inlineData());
+            m_cap = std::exchange(other.m_cap, N);
+            m_size = other.m_size;
+        }
+        other.m_size = 0;
+    }
+
+    void reallocate(std::size_t newCap) {
+        if constexpr (isTriviallyRelocatable<T> && ReallocatingAllocator<Alloc, T>) {
+            if (!isInline()) {
+                m_data = m_allocator.reallocate(m_data, m_cap, newCap);
+                m_cap = newCap;
+                return;
+            }
+        }
+
+        T* newData = m_allocator.allocate(newCap);
+        relocateElements(newData, m_data, m_size);
+        releaseHeap();
+        m_data = newData;
+        m_cap = newCap;
+    }
+};
@@ -0,0 +1,279 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <ranges>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+// Smallest unsigned integer type able to represent every value in [0, N].
+template<std::size_t N>
+using StaticSizeType = std::conditional_t<
+    N <= std::numeric_limits<std::uint8_t>::max(), std::uint8_t,
+    std::conditional_t<N <= std::numeric_limits<std::uint16_t>::max(), std::uint16_t,
+                       std::conditional_t<N <= std::numeric_limits<std::uint32_t>::max(), std::uint32_t,
+                                          std::uint64_t>>>;
+
+// A vector with a fixed capacity of N elements stored inline. It never allocates, and unlike
+// std::array<T, N> it does not construct elements until they are pushed. Every operation is
+// constexpr; trivial element types can be used in constant evaluation.
+template<typename T, std::size_t N>
+class StaticVector {
+public:
+    using iterator = T*;
+    using const_iterator = const T*;
+    using size_type = StaticSizeType<N>;
+
+    constexpr StaticVector() noexcept = default;
+
+    constexpr StaticVector(std::size_t count, const T& elem = T{}) { assign(count, elem); }
+
+    constexpr StaticVector(std::initializer_list<T> init) { assign(init.begin(), init.end()); }
+
+    constexpr StaticVector(const StaticVector& other) { assign(other.begin(), other.end()); }
+
+    constexpr StaticVector(StaticVector&& other) noexcept(std::is_nothrow_move_constructible_v<T>) {
+        for (std::size_t i = 0; i < other.m_size; ++i) {
+            std::construct_at(data() + i, std::move(other[i]));
+        }
+        m_size = other.m_size;
+    }
+
+#if defined(__cpp_lib_containers_ranges)
+    template<std::ranges::input_range R>
+    constexpr StaticVector(std::from_range_t, R&& range) {
+        appendRange(std::forward<R>(range));
+    }
+#endif
+
+    constexpr StaticVector& operator=(const StaticVector& other) {
+        if (this != &other) {
+            assign(other.begin(), other.end());
+        }
+        return *this;
+    }
+
+    constexpr StaticVector& operator=(StaticVector&& other) noexcept(std::is_nothrow_move_constructible_v<T>) {
+        if (this != &other) {
+            clear();
+            for (std::size_t i = 0; i < other.m_size; ++i) {
+                std::construct_at(data() + i, std::move(other[i]));
+            }
+            m_size = other.m_size;
+        }
+        return *this;
+    }
+
+    constexpr ~StaticVector()
+        requires std::is_trivially_destructible_v<T>
+    = default;
+
+    constexpr ~StaticVector() { clear(); }
+
+    friend constexpr bool operator==(const StaticVector& lhs, const StaticVector& rhs) {
+        return std::equal(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+    }
+
+    friend constexpr auto operator<=>(const StaticVector& lhs, const StaticVector& rhs) {
+        return std::lexicographical_compare_three_way(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+    }
+
+    [[nodiscard]] constexpr T& operator[](std::size_t idx) { return data()[idx]; }
+    [[nodiscard]] constexpr const T& operator[](std::size_t idx) const { return data()[idx]; }
+
+    constexpr T& at(std::size_t idx) {
+        if (idx >= m_size)
+            throw std::out_of_range{"Index out of range"};
+        return data()[idx];
+    }
+
+    constexpr const T& at(std::size_t idx) const {
+        if (idx >= m_size)
+            throw std::out_of_range{"Index out of range"};
+        return data()[idx];
+    }
+
+    [[nodiscard]] constexpr T& front() { return data()[0]; }
+    [[nodiscard]] constexpr const T& front() const { return data()[0]; }
+    [[nodiscard]] constexpr T& back() { return data()[m_size - 1]; }
+    [[nodiscard]] constexpr const T& back() const { return data()[m_size - 1]; }
+    [[nodiscard]] constexpr T* data() noexcept { return m_storage.elems; }
+    [[nodiscard]] constexpr const T* data() const noexcept { return m_storage.elems; }
+    [[nodiscard]] constexpr std::size_t size() const noexcept { return m_size; }
+    [[nodiscard]] static constexpr std::size_t capacity() noexcept { return N; }
+    [[nodiscard]] constexpr bool empty() const noexcept { return m_size == 0; }
+    [[nodiscard]] constexpr bool full() const noexcept { return m_size == N; }
+
+    constexpr void reserve(std::size_t newCap) const {
+        if (newCap > N) {
+            throw std::out_of_range{"StaticVector capacity exceeded"};
+        }
+    }
+
+    constexpr void shrinkToFit() const noexcept {}
+
+    constexpr void resize(std::size_t newSize, const T& elem = T{}) {
+        reserve(newSize);
+        if (newSize < m_size) {
+            std::destroy(begin() + newSize, end());
+        } else {
+            for (std::size_t i = m_size; i < newSize; ++i) {
+                std::construct_at(data() + i, elem);
+            }
+        }
+        m_size = static_cast<size_type>(newSize);
+    }
+
+    constexpr void clear() noexcept {
+        std::destroy(begin(), end());
+        m_size = 0;
+    }
+
+    constexpr void pushBack(const T& value) { emplaceBack(value); }
+
+    constexpr void pushBack(T&& value) { emplaceBack(std::move(value)); }
+
+    template<typename... Args>
+    constexpr void emplaceBack(Args&&... args) {
+        if (full()) {
+            throw std::out_of_range{"StaticVector is full"};
+        }
+        unsafeEmplaceBack(std::forward<Args>(args)...);
+    }
+
+    // Appends value if there is room and reports whether it did; never throws on a full vector.
+    constexpr bool tryPushBack(const T& value) { return tryEmplaceBack(value); }
+
+    constexpr bool tryPushBack(T&& value) { return tryEmplaceBack(std::move(value)); }
+
+    template<typename... Args>
+    constexpr bool tryEmplaceBack(Args&&... args) {
+        if (full()) {
+            return false;
+        }
+        unsafeEmplaceBack(std::forward<Args>(args)...);
+        return true;
+    }
+
+    constexpr void popBack() {
+        if (m_size > 0) {
+            std::destroy_at(data() + m_size - 1);
+            --m_size;
+        }
+    }
+
+    constexpr void erase(const T& value) {
+        auto newEnd = std::remove(begin(), end(), value);
+        std::destroy(newEnd, end());
+        m_size = static_cast<size_type>(newEnd - begin());
+    }
+
+    constexpr iterator erase(const_iterator pos) { return erase(pos, pos + 1); }
+
+    constexpr iterator erase(const_iterator first, const_iterator last) {
+        iterator dst = begin() + (first - cbegin());
+        iterator newEnd = std::move(begin() + (last - cbegin()), end(), dst);
+        std::destroy(newEnd, end());
+        m_size = static_cast<size_type>(newEnd - begin());
+        return dst;
+    }
+
+    constexpr void assign(std::size_t count, const T& value) {
+        reserve(count);
+        clear();
+        for (std::size_t i = 0; i < count; ++i) {
+            std::construct_at(data() + i, value);
+        }
+        m_size = static_cast<size_type>(count);
+    }
+
+    template<std::input_iterator InputIt, std::sentinel_for<InputIt> Sent>
+    constexpr void assign(InputIt first, Sent last) {
+        clear();
+        insert(begin(), first, last);
+    }
+
+    constexpr void assign(std::initializer_list<T> init) { assign(init.begin(), init.end()); }
+
+    template<std::input_iterator InputIt, std::sentinel_for<InputIt> Sent>
+    constexpr iterator insert(const_iterator pos, InputIt first, Sent last) {
+        std::size_t idx = static_cast<std::size_t>(pos - cbegin());
+        std::size_t oldSize = m_size;
+
+        if constexpr (std::forward_iterator<InputIt>) {
+            reserve(m_size + static_cast<std::size_t>(std::ranges::distance(first, last)));
+        }
+        try {
+            for (; first != last; ++first) {
+                emplaceBack(*first);
+            }
+        } catch (...) {
+            while (m_size > oldSize) {
+                popBack();
+            }
+            throw;
+        }
+
+        std::rotate(begin() + idx, begin() + oldSize, end());
+        return begin() + idx;
+    }
+
+    template<std::ranges::input_range R>
+    constexpr void appendRange(R&& range) {
+        if constexpr (std::is_rvalue_reference_v<R&&> && !std::ranges::view<std::remove_cvref_t<R>>) {
+            insert(end(), std::make_move_iterator(std::ranges::begin(range)),
+                   std::move_sentinel(std::ranges::end(range)));
+        } else {
+            insert(end(), std::ranges::begin(range), std::ranges::end(range));
+        }
+    }
+
+    [[nodiscard]] constexpr iterator begin() noexcept { return data(); }
+    [[nodiscard]] constexpr const_iterator begin() const noexcept { return data(); }
+    [[nodiscard]] constexpr iterator end() noexcept { return data() + m_size; }
+    [[nodiscard]] constexpr const_iterator end() const noexcept { return data() + m_size; }
+    [[nodiscard]] constexpr const_iterator cbegin() const noexcept { return data(); }
+    [[nodiscard]] constexpr const_iterator cend() const noexcept { return data() + m_size; }
+
+    friend constexpr void swap(StaticVector& first, StaticVector& second) noexcept(
+        std::is_nothrow_move_constructible_v<T>) {
+        StaticVector tmp{std::move(first)};
+        first = std::move(second);
+        second = std::move(tmp);
+    }
+
+private:
+    static constexpr std::size_t storageLen = N == 0 ? 1 : N;
+
+    // Trivial element types live in a plain array that is left default-initialized, which
+    // constant evaluation accepts. Other types need a union so no element is constructed up front.
+    struct TrivialStorage {
+        T elems[storageLen];
+    };
+
+    union NonTrivialStorage {
+        constexpr NonTrivialStorage() noexcept {}
+        constexpr ~NonTrivialStorage() {}
+
+        T elems[storageLen];
+    };
+
+    using Storage = std::conditional_t<std::is_trivially_default_constructible_v<T> &&
+                                           std::is_trivially_destructible_v<T>,
+                                       TrivialStorage, NonTrivialStorage>;
+
+    Storage m_storage;
+    size_type m_size{0};
+
+    template<typename... Args>
+    constexpr void unsafeEmplaceBack(Args&&... args) {
+        std::construct_at(data() + m_size, std::forward<Args>(args)...);
+        ++m_size;
+    }
+};
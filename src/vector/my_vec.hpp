@@ -1,16 +1,32 @@
 #pragma once
 
+#include <algorithm>
 #include <cstddef>
 #include <cstring>
 #include <initializer_list>
+#include <iterator>
 #include <memory>
+#include <ranges>
 #include <stdexcept>
 #include <type_traits>
 #include <utility>
+#include "../simd/simd_find.hpp"
+#include "growth_policy.hpp"
+#include "relocate.hpp"
 
-template<typename T, typename Alloc = std::allocator<T>>
+template<typename It>
+inline constexpr bool isMoveIterator = false;
+
+template<typename It>
+inline constexpr bool isMoveIterator<std::move_iterator<It>> = true;
+
+template<typename T, typename Alloc = std::allocator<T>, GrowthPolicy Growth = GrowDouble,
+         typename Stats = NoVectorStats>
 class Vector {
 public:
+    using iterator = T*;
+    using const_iterator = const T*;
+
     Vector() : m_data{nullptr}, m_size{0}, m_cap{0} {}
 
     Vector(std::size_t count, const T& elem = T{}) {
@@ -43,6 +59,13 @@ public:
         m_size = m_cap = init.size();
     }
 
+#if defined(__cpp_lib_containers_ranges)
+    template<std::ranges::input_range R>
+    Vector(std::from_range_t, R&& range) {
+        appendRange(std::forward<R>(range));
+    }
+#endif
+
     ~Vector() {
         destroyElements(0, m_size);
         deallocateMemory();
@@ -74,6 +97,7 @@ public:
     [[nodiscard]] constexpr std::size_t size() const noexcept { return m_size; }
     [[nodiscard]] constexpr std::size_t capacity() const noexcept { return m_cap; }
     [[nodiscard]] constexpr bool empty() const noexcept { return m_size == 0; }
+    [[nodiscard]] constexpr const Stats& stats() const noexcept { return m_stats; }
 
     void reserve(std::size_t newCap) {
         if (newCap > m_cap) {
@@ -100,6 +124,38 @@ public:
         m_size = newSize;
     }
 
+    // Like resize, but new elements are default-initialized, so trivial types are left
+    // uninitialized for the caller to overwrite (e.g. as the target of a read(2)). Capacity grows
+    // geometrically so that repeatedly extending a buffer stays amortized O(1) per element.
+    void resizeForOverwrite(std::size_t newSize) {
+        if (newSize < m_size) {
+            destroyElements(newSize, m_size);
+        } else if (newSize > m_size) {
+            if (newSize > m_cap) {
+                reallocate(nextCapacity(newSize));
+            }
+            for (std::size_t i = m_size; i < newSize; ++i) {
+                ::new (m_data + i) T;
+            }
+        }
+
+        m_size = newSize;
+    }
+
+    // Modeled on basic_string::resize_and_overwrite: makes room for newSize elements, lets op write
+    // into data() and then keeps the first op(data(), newSize) elements, which must not exceed newSize.
+    template<typename Op>
+        requires std::is_invocable_r_v<std::size_t, Op, T*, std::size_t>
+    void resizeAndOverwrite(std::size_t newSize, Op op) {
+        resizeForOverwrite(newSize);
+        std::size_t keep = static_cast<std::size_t>(std::move(op)(m_data, newSize));
+        if (keep > newSize) {
+            throw std::length_error{"resizeAndOverwrite: operation returned a size past the requested size"};
+        }
+        destroyElements(keep, m_size);
+        m_size = keep;
+    }
+
     void clear() noexcept {
         destroyElements(0, m_size);
         m_size = 0;
@@ -134,12 +190,33 @@ public:
         }
     }
 
+    // Removes every element equal to value. Types with SIMD search kernels are compacted with
+    // vector instructions; everything else goes through std::remove.
     constexpr void erase(const T& value) {
+        if constexpr (SimdSearchable<T>) {
+            if (!std::is_constant_evaluated()) {
+                m_size = simdRemove(m_data, m_size, value);
+                return;
+            }
+        }
         auto newEnd = std::remove(begin(), end(), value);
         destroyElements(newEnd - begin(), m_size);
         m_size = newEnd - begin();
     }
 
+    [[nodiscard]] iterator find(const T& value) { return m_data + findIndex(value); }
+    [[nodiscard]] const_iterator find(const T& value) const { return m_data + findIndex(value); }
+
+    [[nodiscard]] std::size_t count(const T& value) const {
+        if constexpr (SimdSearchable<T>) {
+            return simdCount(m_data, m_size, value);
+        } else {
+            return static_cast<std::size_t>(std::count(begin(), end(), value));
+        }
+    }
+
+    [[nodiscard]] bool contains(const T& value) const { return findIndex(value) != m_size; }
+
     void assign(std::size_t count, const T& value) {
         clear();
         if (count > m_cap) {
@@ -149,10 +226,77 @@ public:
         m_size = count;
     }
 
-    void assign(std::initializer_list<T> init) { assign(init.size(), init.begin(), init.end()); }
+    template<std::input_iterator InputIt, std::sentinel_for<InputIt> Sent>
+    void assign(InputIt first, Sent last) {
+        clear();
+        if constexpr (std::forward_iterator<InputIt>) {
+            std::size_t count = static_cast<std::size_t>(std::ranges::distance(first, last));
+            if (count > m_cap) {
+                reallocate(count);
+            }
+            constructElementsFrom(0, first, count);
+            m_size = count;
+        } else {
+            for (; first != last; ++first) {
+                emplaceBack(*first);
+            }
+        }
+    }
 
-    using iterator = T*;
-    using const_iterator = const T*;
+    void assign(std::initializer_list<T> init) { assign(init.begin(), init.end()); }
+
+    // Inserts [first, last) before pos, growing at most once when the length of the range is known.
+    template<std::input_iterator InputIt, std::sentinel_for<InputIt> Sent>
+    iterator insert(const_iterator pos, InputIt first, Sent last) {
+        std::size_t idx = static_cast<std::size_t>(pos - m_data);
+        std::size_t oldSize = m_size;
+
+        if constexpr (std::forward_iterator<InputIt>) {
+            std::size_t count = static_cast<std::size_t>(std::ranges::distance(first, last));
+            if (count == 0) {
+                return m_data + idx;
+            }
+            if (m_size + count > m_cap) {
+                std::size_t newCap = nextCapacity(m_size + count);
+                T* newData = m_allocator.allocate(newCap);
+                try {
+                    constructRange(newData + idx, first, count);
+                } catch (...) {
+                    m_allocator.deallocate(newData, newCap);
+                    throw;
+                }
+                relocateElements(newData, m_data, idx);
+                relocateElements(newData + idx + count, m_data + idx, m_size - idx);
+
+                recordGrowth(newCap);
+                deallocateMemory();
+                m_data = newData;
+                m_cap = newCap;
+                m_size += count;
+                return m_data + idx;
+            }
+            constructElementsFrom(m_size, first, count);
+            m_size += count;
+        } else {
+            for (; first != last; ++first) {
+                emplaceBack(*first);
+            }
+        }
+
+        std::rotate(m_data + idx, m_data + oldSize, m_data + m_size);
+        return m_data + idx;
+    }
+
+    // Appends every element of range, moving them out when range is an owning rvalue.
+    template<std::ranges::input_range R>
+    void appendRange(R&& range) {
+        if constexpr (std::is_rvalue_reference_v<R&&> && !std::ranges::view<std::remove_cvref_t<R>>) {
+            insert(end(), std::make_move_iterator(std::ranges::begin(range)),
+                   std::move_sentinel(std::ranges::end(range)));
+        } else {
+            insert(end(), std::ranges::begin(range), std::ranges::end(range));
+        }
+    }
 
     [[nodiscard]] iterator begin() noexcept { return m_data; }
     [[nodiscard]] const_iterator begin() const noexcept { return m_data; }
@@ -166,6 +310,7 @@ public:
         swap(first.m_data, second.m_data);
         swap(first.m_size, second.m_size);
         swap(first.m_cap, second.m_cap);
+        swap(first.m_stats, second.m_stats);
     }
 
 private:
@@ -173,10 +318,12 @@ private:
     std::size_t m_size{};
     std::size_t m_cap{};
     Alloc m_allocator{};
+    [[no_unique_address]] Stats m_stats{};
 
     void allocateMemory(std::size_t count) {
         m_data = m_allocator.allocate(count);
         m_cap = count;
+        m_stats.onAllocate(count);
     }
 
     void deallocateMemory() {
@@ -195,8 +342,31 @@ private:
 
     template<typename InputIt>
     void constructElementsFrom(std::size_t start, InputIt first, std::size_t count) {
-        for (std::size_t i = 0; i < count; ++i) {
-            ::new (m_data + start + i) T{*(first + i)};
+        constructRange(m_data + start, first, count);
+    }
+
+    // Copy-constructs count elements from first into raw memory, using memcpy when the source is
+    // contiguous storage of T and T is trivially copyable.
+    template<typename InputIt>
+    static void constructRange(T* dst, InputIt first, std::size_t count) {
+        if constexpr (isMoveIterator<InputIt> && std::is_trivially_copyable_v<T>) {
+            constructRange(dst, first.base(), count);
+        } else if constexpr (std::contiguous_iterator<InputIt> && std::is_trivially_copyable_v<T> &&
+                      std::is_same_v<std::iter_value_t<InputIt>, T>) {
+            if (count > 0) {
+                std::memcpy(static_cast<void*>(dst), static_cast<const void*>(std::to_address(first)),
+                            count * sizeof(T));
+            }
+        } else {
+            std::size_t i = 0;
+            try {
+                for (; i < count; ++i, ++first) {
+                    ::new (dst + i) T(*first);
+                }
+            } catch (...) {
+                std::destroy_n(dst, i);
+                throw;
+            }
         }
     }
 
@@ -207,27 +377,45 @@ private:
     }
 
     void reallocate(std::size_t newCap) {
-        T* newData = m_allocator.allocate(newCap);
-
-        if constexpr (std::is_nothrow_move_constructible_v<T>) {
-            for (std::size_t i = 0; i < m_size; ++i) {
-                ::new (newData + i) T(std::move(m_data[i]));
-                m_data[i].~T();
-            }
-        } else {
-            for (std::size_t i = 0; i < m_size; ++i) {
-                ::new (newData + i) T(m_data[i]);
-                m_data[i].~T();
+        if constexpr (isTriviallyRelocatable<T> && ReallocatingAllocator<Alloc, T>) {
+            if (m_data) {
+                m_stats.onReallocate(newCap, 0);
+            } else {
+                m_stats.onAllocate(newCap);
             }
+            m_data = m_allocator.reallocate(m_data, m_cap, newCap);
+            m_cap = newCap;
+            return;
         }
 
+        T* newData = m_allocator.allocate(newCap);
+        relocateElements(newData, m_data, m_size);
+        recordGrowth(newCap);
+
         deallocateMemory();
         m_data = newData;
         m_cap = newCap;
     }
 
-    void grow() {
-        std::size_t newCap = (m_cap == 0) ? 4 : m_cap * 2;
-        reallocate(newCap);
+    [[nodiscard]] std::size_t findIndex(const T& value) const {
+        if constexpr (SimdSearchable<T>) {
+            return simdFind(m_data, m_size, value);
+        } else {
+            return static_cast<std::size_t>(std::find(begin(), end(), value) - begin());
+        }
+    }
+
+    void recordGrowth(std::size_t newCap) noexcept {
+        if (m_data) {
+            m_stats.onReallocate(newCap, m_size * sizeof(T));
+        } else {
+            m_stats.onAllocate(newCap);
+        }
+    }
+
+    [[nodiscard]] std::size_t nextCapacity(std::size_t required) const noexcept {
+        return Growth::nextCapacity(m_cap, required, sizeof(T));
     }
+
+    void grow() { reallocate(nextCapacity(m_size + 1)); }
 };
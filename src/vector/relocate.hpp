@@ -0,0 +1,44 @@
+#pragma once
+
+#include <concepts>
+#include <cstddef>
+#include <cstring>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+// A type is trivially relocatable when moving it to a new address and ending the lifetime of the
+// source is equivalent to copying its bytes. Every trivially copyable type qualifies; specialize
+// this trait for types such as owning handles that are safe to memcpy but not trivially copyable.
+template<typename T>
+struct TriviallyRelocatable : std::bool_constant<std::is_trivially_copyable_v<T>> {};
+
+template<typename T>
+inline constexpr bool isTriviallyRelocatable = TriviallyRelocatable<std::remove_cv_t<T>>::value;
+
+// Allocators that can grow or shrink a block in place (or move it without the caller copying
+// bytes) expose reallocate(). Containers only use it for trivially relocatable element types.
+template<typename Alloc, typename T>
+concept ReallocatingAllocator = requires(Alloc& alloc, T* ptr, std::size_t n) {
+    { alloc.reallocate(ptr, n, n) } -> std::same_as<T*>;
+};
+
+// Moves count elements from src into the uninitialized memory at dst and destroys the sources.
+template<typename T>
+void relocateElements(T* dst, T* src, std::size_t count) {
+    if constexpr (isTriviallyRelocatable<T>) {
+        if (count > 0) {
+            std::memcpy(static_cast<void*>(dst), static_cast<const void*>(src), count * sizeof(T));
+        }
+    } else if constexpr (std::is_nothrow_move_constructible_v<T> || !std::is_copy_constructible_v<T>) {
+        for (std::size_t i = 0; i < count; ++i) {
+            ::new (dst + i) T(std::move(src[i]));
+            src[i].~T();
+        }
+    } else {
+        for (std::size_t i = 0; i < count; ++i) {
+            ::new (dst + i) T(src[i]);
+            src[i].~T();
+        }
+    }
+}
@@ -0,0 +1,358 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <numeric>
+#include <ranges>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// Sorting for Vector and any other contiguous range: an LSD radix sort for integer and floating
+// point keys, a parallel radix sort that partitions on the most significant varying byte (an MSD
+// pass followed by LSD passes per bucket), a parallel sample sort for arbitrary comparators, and
+// adaptiveSort(), which picks one of them (or std::sort) from the input size and key type.
+
+template<typename K>
+concept RadixSortableKey = std::is_arithmetic_v<K>;
+
+template<typename R, typename Proj>
+using ProjectedKey = std::remove_cvref_t<std::invoke_result_t<Proj&, std::ranges::range_reference_t<R>>>;
+
+// Maps a key to an unsigned integer with the same ordering: signed integers get their sign bit
+// flipped and IEEE floats are turned into sign-magnitude order (NaNs end up at either end).
+template<RadixSortableKey K>
+constexpr auto radixKey(K key) noexcept {
+    if constexpr (std::is_same_v<K, bool>) {
+        return static_cast<std::uint8_t>(key);
+    } else if constexpr (std::is_floating_point_v<K>) {
+        static_assert(sizeof(K) == 4 || sizeof(K) == 8, "only 32 and 64 bit floating point keys are supported");
+        using U = std::conditional_t<sizeof(K) == 4, std::uint32_t, std::uint64_t>;
+        constexpr U signBit = U{1} << (sizeof(U) * 8 - 1);
+        U bits = std::bit_cast<U>(key);
+        return (bits & signBit) ? static_cast<U>(~bits) : static_cast<U>(bits | signBit);
+    } else if constexpr (std::is_signed_v<K>) {
+        using U = std::make_unsigned_t<K>;
+        return static_cast<U>(static_cast<U>(key) ^ (U{1} << (sizeof(U) * 8 - 1)));
+    } else {
+        return static_cast<std::make_unsigned_t<K>>(key);
+    }
+}
+
+struct SortThreads {
+    static unsigned available() noexcept { return std::max(1u, std::thread::hardware_concurrency()); }
+
+    // Runs fn(0) .. fn(count - 1) on count threads, using the calling thread for the first one.
+    template<typename Fn>
+    static void run(unsigned count, Fn&& fn) {
+        std::vector<std::thread> workers;
+        workers.reserve(count > 0 ? count - 1 : 0);
+        for (unsigned t = 1; t < count; ++t) {
+            workers.emplace_back([&fn, t] { fn(t); });
+        }
+        fn(0u);
+        for (auto& worker: workers) {
+            worker.join();
+        }
+    }
+};
+
+struct RadixSortImpl {
+    using Histogram = std::array<std::size_t, 256>;
+
+    // Sorts data[0, n) by the lowest `bytes` bytes of radixKey(proj(elem)), using scratch[0, n) as
+    // the ping-pong buffer. Digits that are equal for every element are skipped. The result always
+    // ends up in data.
+    template<typename T, typename Proj>
+    static void lsd(T* data, T* scratch, std::size_t n, Proj& proj, std::size_t bytes) {
+        if (n < 2 || bytes == 0) {
+            return;
+        }
+        if (n <= 64) {
+            insertionSort(data, n, proj, bytes);
+            return;
+        }
+
+        using Key = decltype(radixKey(std::invoke(proj, *data)));
+        std::array<Histogram, sizeof(Key)> counts{};
+        for (std::size_t i = 0; i < n; ++i) {
+            Key key = radixKey(std::invoke(proj, data[i]));
+            for (std::size_t b = 0; b < bytes; ++b) {
+                ++counts[b][digit(key, b * 8)];
+            }
+        }
+
+        T* src = data;
+        T* dst = scratch;
+        for (std::size_t b = 0; b < bytes; ++b) {
+            Histogram& count = counts[b];
+            if (std::ranges::any_of(count, [n](std::size_t c) { return c == n; })) {
+                continue;
+            }
+            std::size_t offset = 0;
+            for (auto& c: count) {
+                offset += std::exchange(c, offset);
+            }
+            for (std::size_t i = 0; i < n; ++i) {
+                std::size_t d = digit(radixKey(std::invoke(proj, src[i])), b * 8);
+                dst[count[d]++] = std::move(src[i]);
+            }
+            std::swap(src, dst);
+        }
+
+        if (src != data) {
+            std::move(src, src + n, data);
+        }
+    }
+
+    // Stable insertion sort on the same partial key, for inputs too small to amortize histograms.
+    template<typename T, typename Proj>
+    static void insertionSort(T* data, std::size_t n, Proj& proj, std::size_t bytes) {
+        auto key = [&](const T& elem) { return lowBytes(radixKey(std::invoke(proj, elem)), bytes); };
+        for (std::size_t i = 1; i < n; ++i) {
+            if (!(key(data[i]) < key(data[i - 1]))) {
+                continue;
+            }
+            T elem = std::move(data[i]);
+            auto elemKey = key(elem);
+            std::size_t j = i;
+            for (; j > 0 && elemKey < key(data[j - 1]); --j) {
+                data[j] = std::move(data[j - 1]);
+            }
+            data[j] = std::move(elem);
+        }
+    }
+
+    template<typename Key>
+    static constexpr std::size_t digit(Key key, std::size_t shift) noexcept {
+        return static_cast<std::size_t>((key >> shift) & 0xFF);
+    }
+
+    template<typename Key>
+    static constexpr Key lowBytes(Key key, std::size_t bytes) noexcept {
+        return bytes >= sizeof(Key) ? key : static_cast<Key>(key & ((Key{1} << (bytes * 8)) - 1));
+    }
+
+    template<typename T, typename Proj>
+    static void parallel(T* data, std::size_t n, Proj& proj, unsigned threads) {
+        using Key = decltype(radixKey(std::invoke(proj, *data)));
+
+        // Only bytes below the highest bit where the smallest and largest key differ can vary.
+        std::vector<std::pair<Key, Key>> ranges(threads, {std::numeric_limits<Key>::max(), Key{0}});
+        SortThreads::run(threads, [&](unsigned t) {
+            auto [lo, hi] = ranges[t];
+            for (std::size_t i = n * t / threads, end = n * (t + 1) / threads; i < end; ++i) {
+                Key key = radixKey(std::invoke(proj, data[i]));
+                lo = std::min(lo, key);
+                hi = std::max(hi, key);
+            }
+            ranges[t] = {lo, hi};
+        });
+        Key lo = std::numeric_limits<Key>::max();
+        Key hi = 0;
+        for (auto [l, h]: ranges) {
+            lo = std::min(lo, l);
+            hi = std::max(hi, h);
+        }
+        if (lo == hi) {
+            return;
+        }
+        std::size_t shift = (static_cast<std::size_t>(std::bit_width(static_cast<Key>(lo ^ hi))) - 1) / 8 * 8;
+
+        // Partition on that byte: per-thread histograms, then a stable parallel scatter.
+        std::vector<Histogram> counts(threads, Histogram{});
+        SortThreads::run(threads, [&](unsigned t) {
+            for (std::size_t i = n * t / threads, end = n * (t + 1) / threads; i < end; ++i) {
+                ++counts[t][digit(radixKey(std::invoke(proj, data[i])), shift)];
+            }
+        });
+        Histogram bucketStart{};
+        std::size_t offset = 0;
+        for (std::size_t d = 0; d < 256; ++d) {
+            bucketStart[d] = offset;
+            for (unsigned t = 0; t < threads; ++t) {
+                offset += std::exchange(counts[t][d], offset);
+            }
+        }
+
+        auto scratch = std::make_unique_for_overwrite<T[]>(n);
+        SortThreads::run(threads, [&](unsigned t) {
+            Histogram& cursor = counts[t];
+            for (std::size_t i = n * t / threads, end = n * (t + 1) / threads; i < end; ++i) {
+                std::size_t d = digit(radixKey(std::invoke(proj, data[i])), shift);
+                scratch[cursor[d]++] = std::move(data[i]);
+            }
+        });
+
+        // Sort every bucket on the remaining lower bytes, largest buckets first.
+        std::vector<std::size_t> order(256);
+        std::iota(order.begin(), order.end(), std::size_t{0});
+        auto bucketSize = [&](std::size_t d) { return (d == 255 ? n : bucketStart[d + 1]) - bucketStart[d]; };
+        std::ranges::sort(order, std::greater<>{}, bucketSize);
+
+        std::atomic<std::size_t> next{0};
+        SortThreads::run(threads, [&](unsigned) {
+            for (std::size_t i = next++; i < order.size(); i = next++) {
+                std::size_t d = order[i];
+                std::size_t begin = bucketStart[d];
+                std::size_t len = bucketSize(d);
+                lsd(scratch.get() + begin, data + begin, len, proj, shift / 8);
+                std::move(scratch.get() + begin, scratch.get() + begin + len, data + begin);
+            }
+        });
+    }
+};
+
+// Stable LSD radix sort by an integer or floating point key. Needs n extra elements of scratch.
+template<std::ranges::contiguous_range R, typename Proj = std::identity>
+    requires RadixSortableKey<ProjectedKey<R, Proj>> && std::default_initializable<std::ranges::range_value_t<R>>
+void radixSort(R&& range, Proj proj = {}) {
+    using T = std::ranges::range_value_t<R>;
+    std::size_t n = std::ranges::size(range);
+    if (n < 2) {
+        return;
+    }
+    auto scratch = std::make_unique_for_overwrite<T[]>(n);
+    RadixSortImpl::lsd(std::ranges::data(range), scratch.get(), n, proj, sizeof(radixKey(ProjectedKey<R, Proj>{})));
+}
+
+// Radix sort spread over threads: the input is partitioned on its most significant varying byte
+// and the resulting buckets are radix sorted concurrently. Not stable.
+template<std::ranges::contiguous_range R, typename Proj = std::identity>
+    requires RadixSortableKey<ProjectedKey<R, Proj>> && std::default_initializable<std::ranges::range_value_t<R>>
+void parallelRadixSort(R&& range, Proj proj = {}, unsigned threads = SortThreads::available()) {
+    std::size_t n = std::ranges::size(range);
+    if (n < 2) {
+        return;
+    }
+    RadixSortImpl::parallel(std::ranges::data(range), n, proj, std::max(1u, threads));
+}
+
+// Parallel sample sort for any strict weak ordering. Each thread classifies a slice of the input
+// against sorted splitters drawn from a sample, the slices are scattered into per-splitter buckets
+// and every bucket is then sorted with std::sort on its own thread. Not stable. The sample and the
+// splitters hold projected keys, so elements only need to be movable; the keys must be copyable.
+template<std::ranges::contiguous_range R, typename Comp = std::ranges::less, typename Proj = std::identity>
+    requires std::sortable<std::ranges::iterator_t<R>, Comp, Proj> &&
+             std::default_initializable<std::ranges::range_value_t<R>> && std::copyable<ProjectedKey<R, Proj>>
+void parallelSort(R&& range, Comp comp = {}, Proj proj = {}, unsigned threads = SortThreads::available()) {
+    using T = std::ranges::range_value_t<R>;
+    T* data = std::ranges::data(range);
+    std::size_t n = std::ranges::size(range);
+    threads = std::max(1u, threads);
+    std::size_t buckets = std::size_t{threads} * 4;
+    std::size_t oversample = 32;
+    std::size_t sampleSize = buckets * oversample;
+    if (threads == 1 || n < sampleSize * 16) {
+        std::ranges::sort(data, data + n, comp, proj);
+        return;
+    }
+
+    using Key = ProjectedKey<R, Proj>;
+    auto less = [&](T& a, T& b) { return std::invoke(comp, std::invoke(proj, a), std::invoke(proj, b)); };
+
+    std::vector<Key> sample;
+    sample.reserve(sampleSize);
+    std::size_t stride = n / sampleSize;
+    for (std::size_t i = 0; i < sampleSize; ++i) {
+        sample.push_back(std::invoke(proj, data[i * stride + (i * 7919) % stride]));
+    }
+    std::ranges::sort(sample, comp);
+    std::vector<Key> splitters;
+    splitters.reserve(buckets - 1);
+    for (std::size_t b = 1; b < buckets; ++b) {
+        splitters.push_back(sample[b * oversample]);
+    }
+
+    auto bucketOf = [&](T& elem) {
+        return static_cast<std::size_t>(std::ranges::upper_bound(splitters, std::invoke(proj, elem), comp) -
+                                        splitters.begin());
+    };
+
+    std::vector<std::vector<std::size_t>> counts(threads, std::vector<std::size_t>(buckets, 0));
+    std::vector<std::uint32_t> bucketIds(n);
+    SortThreads::run(threads, [&](unsigned t) {
+        for (std::size_t i = n * t / threads, end = n * (t + 1) / threads; i < end; ++i) {
+            auto b = bucketOf(data[i]);
+            bucketIds[i] = static_cast<std::uint32_t>(b);
+            ++counts[t][b];
+        }
+    });
+
+    std::vector<std::size_t> bucketStart(buckets + 1, 0);
+    std::size_t offset = 0;
+    for (std::size_t b = 0; b < buckets; ++b) {
+        bucketStart[b] = offset;
+        for (unsigned t = 0; t < threads; ++t) {
+            offset += std::exchange(counts[t][b], offset);
+        }
+    }
+    bucketStart[buckets] = n;
+
+    auto scratch = std::make_unique_for_overwrite<T[]>(n);
+    SortThreads::run(threads, [&](unsigned t) {
+        auto& cursor = counts[t];
+        for (std::size_t i = n * t / threads, end = n * (t + 1) / threads; i < end; ++i) {
+            scratch[cursor[bucketIds[i]]++] = std::move(data[i]);
+        }
+    });
+
+    std::atomic<std::size_t> next{0};
+    SortThreads::run(threads, [&](unsigned) {
+        for (std::size_t b = next++; b < buckets; b = next++) {
+            T* first = scratch.get() + bucketStart[b];
+            T* last = scratch.get() + bucketStart[b + 1];
+            std::sort(first, last, less);
+            std::move(first, last, data + bucketStart[b]);
+        }
+    });
+}
+
+struct SortThresholds {
+    static constexpr std::size_t radix = std::size_t{1} << 11;
+    // Above this size the MSD partition pays off even on one thread: every bucket's LSD passes
+    // then run over a cache-sized slice instead of sweeping the whole input once per byte.
+    static constexpr std::size_t msdRadix = std::size_t{1} << 16;
+    static constexpr std::size_t parallel = std::size_t{1} << 17;
+};
+
+// Sorts range with whichever algorithm suits it: std::sort for small inputs, radix sort for
+// ascending arithmetic keys and sample sort for other orderings on all cores for large inputs.
+template<std::ranges::contiguous_range R, typename Comp = std::ranges::less, typename Proj = std::identity>
+    requires std::sortable<std::ranges::iterator_t<R>, Comp, Proj>
+void adaptiveSort(R&& range, Comp comp = {}, Proj proj = {}) {
+    using T = std::ranges::range_value_t<R>;
+    std::size_t n = std::ranges::size(range);
+    unsigned threads = SortThreads::available();
+
+    if constexpr (std::default_initializable<T>) {
+        if constexpr (RadixSortableKey<ProjectedKey<R, Proj>> &&
+                      (std::is_same_v<Comp, std::ranges::less> || std::is_same_v<Comp, std::less<>>)) {
+            if (n >= SortThresholds::msdRadix) {
+                parallelRadixSort(range, proj, n >= SortThresholds::parallel ? threads : 1u);
+                return;
+            }
+            if (n >= SortThresholds::radix) {
+                radixSort(range, proj);
+                return;
+            }
+        } else if constexpr (std::copyable<ProjectedKey<R, Proj>>) {
+            if (threads > 1 && n >= SortThresholds::parallel) {
+                parallelSort(range, comp, proj, threads);
+                return;
+            }
+        }
+    }
+    std::ranges::sort(range, comp, proj);
+}
@@ -0,0 +1,156 @@
+#include <gtest/gtest.h>
+#include <atomic>
+#include <cstddef>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+#include "../src/hash/concurrent_hashmap.hpp"
+#include "../src/string/my_string.hpp"
+
+class MyConcurrentHashMapTest : public testing::Test {
+protected:
+    ConcurrentHashMap<int, int> map;
+
+    template<typename Fn>
+    static void runThreads(std::size_t threads, Fn fn) {
+        std::vector<std::thread> workers;
+        for (std::size_t t = 0; t < threads; ++t) {
+            workers.emplace_back(fn, t);
+        }
+        for (auto& worker: workers) {
+            worker.join();
+        }
+    }
+};
+
+TEST_F(MyConcurrentHashMapTest, ShardCountIsAPowerOfTwo) {
+    EXPECT_EQ(map.shardCount(), 64);
+    EXPECT_EQ((ConcurrentHashMap<int, int>(5).shardCount()), 8);
+    EXPECT_EQ((ConcurrentHashMap<int, int>(0).shardCount()), 1);
+}
+
+TEST_F(MyConcurrentHashMapTest, InsertGetErase) {
+    EXPECT_TRUE(map.empty());
+    map.insert(1, 10);
+    map.insert(1, 11);
+    EXPECT_TRUE(map.try_emplace(2, 20));
+    EXPECT_FALSE(map.try_emplace(2, 21));
+    EXPECT_EQ(map.get(1), 11);
+    EXPECT_EQ(map.get(2), 20);
+    EXPECT_EQ(map.get(3), std::nullopt);
+    EXPECT_TRUE(map.contains(2));
+    EXPECT_EQ(map.size(), 2);
+    EXPECT_TRUE(map.erase(1));
+    EXPECT_FALSE(map.erase(1));
+    EXPECT_EQ(map.size(), 1);
+    map.clear();
+    EXPECT_TRUE(map.empty());
+}
+
+TEST_F(MyConcurrentHashMapTest, VisitDoesNotCopy) {
+    ConcurrentHashMap<int, std::vector<int>> lists;
+    lists.insert(1, std::vector<int>(100, 7));
+    std::size_t seen = 0;
+    EXPECT_TRUE(lists.visit(1, [&](const std::vector<int>& list) { seen = list.size(); }));
+    EXPECT_FALSE(lists.visit(2, [&](const std::vector<int>&) { seen = 0; }));
+    EXPECT_EQ(seen, 100);
+}
+
+TEST_F(MyConcurrentHashMapTest, UpsertInsertsThenUpdates) {
+    EXPECT_TRUE(map.upsert(5, 1, [](int& v) { v += 100; }));
+    EXPECT_FALSE(map.upsert(5, 1, [](int& v) { v += 100; }));
+    EXPECT_EQ(map.get(5), 101);
+}
+
+TEST_F(MyConcurrentHashMapTest, ComputeInsertsUpdatesAndErases) {
+    auto increment = [](int* current) -> std::optional<int> { return current ? *current + 1 : 1; };
+    EXPECT_TRUE(map.compute(9, increment));
+    EXPECT_TRUE(map.compute(9, increment));
+    EXPECT_EQ(map.get(9), 2);
+
+    auto eraseIfEven = [](int* current) -> std::optional<int> {
+        if (current && *current % 2 == 0) {
+            return std::nullopt;
+        }
+        return current ? std::optional<int>{*current} : std::nullopt;
+    };
+    EXPECT_FALSE(map.compute(9, eraseIfEven));
+    EXPECT_FALSE(map.contains(9));
+    EXPECT_FALSE(map.compute(10, eraseIfEven));
+    EXPECT_FALSE(map.contains(10));
+}
+
+TEST_F(MyConcurrentHashMapTest, TransparentStringLookups) {
+    ConcurrentHashMap<String, int, StringHash, std::equal_to<>> routes;
+    routes.insert(std::string_view{"/health"}, 1);
+    EXPECT_TRUE(routes.contains("/health"));
+    EXPECT_EQ(routes.get(std::string_view{"/health"}), 1);
+    EXPECT_TRUE(routes.erase("/health"));
+}
+
+TEST_F(MyConcurrentHashMapTest, SnapshotAndForEachSeeEveryElement) {
+    for (int i = 0; i < 1000; ++i) {
+        map.insert(i, i * 3);
+    }
+    auto copy = map.snapshot();
+    EXPECT_EQ(copy.size(), 1000);
+    EXPECT_EQ(copy.get(500)->get(), 1500);
+
+    long sum = 0;
+    map.forEach([&](int key, int value) {
+        EXPECT_EQ(value, key * 3);
+        sum += key;
+    });
+    EXPECT_EQ(sum, 999 * 1000 / 2);
+}
+
+TEST_F(MyConcurrentHashMapTest, ConcurrentUpsertsCountExactly) {
+    constexpr std::size_t threads = 8;
+    constexpr int perThread = 20'000;
+    runThreads(threads, [&](std::size_t) {
+        for (int i = 0; i < perThread; ++i) {
+            map.upsert(i % 100, 1, [](int& v) { ++v; });
+        }
+    });
+    EXPECT_EQ(map.size(), 100);
+    long total = 0;
+    map.forEach([&](int, int value) { total += value; });
+    EXPECT_EQ(total, static_cast<long>(threads) * perThread);
+}
+
+TEST_F(MyConcurrentHashMapTest, ConcurrentWritersAndReaders) {
+    constexpr std::size_t writers = 4;
+    constexpr int perWriter = 10'000;
+    std::atomic<bool> done{false};
+    std::atomic<std::size_t> badReads{0};
+    std::thread reader([&] {
+        while (!done.load()) {
+            for (int k = 0; k < 1000; ++k) {
+                if (auto v = map.get(k); v && *v != k) {
+                    ++badReads;
+                }
+            }
+            if (map.snapshot().size() > writers * perWriter) {
+                ++badReads;
+            }
+        }
+    });
+    runThreads(writers, [&](std::size_t t) {
+        for (int i = 0; i < perWriter; ++i) {
+            int key = static_cast<int>(t) * perWriter + i;
+            map.insert(key, key);
+            if (i % 2 == 1) {
+                map.erase(key - 1);
+            }
+        }
+    });
+    done = true;
+    reader.join();
+    EXPECT_EQ(badReads.load(), 0);
+    EXPECT_EQ(map.size(), writers * perWriter / 2);
+    for (int key = 1; key < static_cast<int>(writers) * perWriter; key += 2) {
+        ASSERT_EQ(map.get(key), key);
+    }
+}
@@ -0,0 +1,451 @@
+#include <gtest/gtest.h>
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+#include "../src/hash/hashmap.hpp"
+#include "../src/string/my_string.hpp"
+
+class MyHashMapTest : public testing::Test {
+protected:
+    HashMap<int, int> map;
+};
+
+// Sends every key to the same group and tag, so lookups must probe past full groups and compare keys.
+struct CollidingHash {
+    std::size_t operator()(int) const noexcept { return 0; }
+};
+
+using IncrementalMap = HashMap<int, int, std::hash<int>, std::equal_to<int>, RehashIncremental>;
+
+// Random inserts, erases and lookups, checked against std::unordered_map after every step.
+template<typename Map>
+void expectMatchesUnorderedMap() {
+    Map mine;
+    std::unordered_map<std::string, int> expected;
+    std::mt19937 rng(42);
+    std::uniform_int_distribution<int> keyDist(0, 2000);
+    std::uniform_int_distribution<int> opDist(0, 3);
+    for (int step = 0; step < 50'000; ++step) {
+        std::string key = "key" + std::to_string(keyDist(rng));
+        switch (opDist(rng)) {
+            case 0:
+            case 1:
+                mine.insert(key, step);
+                expected[key] = step;
+                break;
+            case 2:
+                ASSERT_EQ(mine.erase(key), expected.erase(key) == 1);
+                break;
+            default: {
+                auto found = mine.get(key);
+                auto it = expected.find(key);
+                ASSERT_EQ(found.has_value(), it != expected.end());
+                if (found) {
+                    ASSERT_EQ(found->get(), it->second);
+                }
+            }
+        }
+        ASSERT_EQ(mine.size(), expected.size());
+    }
+    ASSERT_EQ(static_cast<std::size_t>(std::distance(mine.begin(), mine.end())), expected.size());
+}
+
+TEST_F(MyHashMapTest, StartsEmpty) {
+    EXPECT_TRUE(map.empty());
+    EXPECT_EQ(map.size(), 0);
+    EXPECT_EQ(map.bucket_count(), 16);
+    EXPECT_FALSE(map.contains(1));
+    EXPECT_FALSE(map.get(1).has_value());
+}
+
+TEST_F(MyHashMapTest, CapacityIsAPowerOfTwo) {
+    EXPECT_EQ((HashMap<int, int>(100).bucket_count()), 128);
+    EXPECT_EQ((HashMap<int, int>(3).bucket_count()), 16);
+}
+
+TEST_F(MyHashMapTest, InsertGetContains) {
+    map.insert(1, 10);
+    map.insert(2, 20);
+    EXPECT_EQ(map.size(), 2);
+    EXPECT_TRUE(map.contains(1));
+    ASSERT_TRUE(map.get(2).has_value());
+    EXPECT_EQ(map.get(2)->get(), 20);
+    EXPECT_FALSE(map.contains(3));
+}
+
+TEST_F(MyHashMapTest, InsertOverwritesExistingKey) {
+    map.insert(7, 1);
+    map.insert(7, 2);
+    EXPECT_EQ(map.size(), 1);
+    EXPECT_EQ(map.get(7)->get(), 2);
+}
+
+TEST_F(MyHashMapTest, SubscriptInsertsDefault) {
+    EXPECT_EQ(map[5], 0);
+    EXPECT_EQ(map.size(), 1);
+    map[5] += 3;
+    map[5] += 4;
+    EXPECT_EQ(map.get(5)->get(), 7);
+}
+
+TEST_F(MyHashMapTest, EraseRemovesOnlyTheKey) {
+    map.insert(1, 1);
+    map.insert(2, 2);
+    EXPECT_TRUE(map.erase(1));
+    EXPECT_FALSE(map.erase(1));
+    EXPECT_FALSE(map.contains(1));
+    EXPECT_TRUE(map.contains(2));
+    EXPECT_EQ(map.size(), 1);
+}
+
+TEST_F(MyHashMapTest, GrowsPastLoadLimit) {
+    for (int i = 0; i < 10'000; ++i) {
+        map.insert(i, i * 2);
+    }
+    EXPECT_EQ(map.size(), 10'000);
+    EXPECT_LE(map.loadFactor(), 0.875f);
+    for (int i = 0; i < 10'000; ++i) {
+        ASSERT_EQ(map.get(i)->get(), i * 2);
+    }
+    EXPECT_FALSE(map.contains(10'000));
+}
+
+TEST_F(MyHashMapTest, CollidingKeysProbeAcrossGroups) {
+    HashMap<int, int, CollidingHash> colliding;
+    for (int i = 0; i < 100; ++i) {
+        colliding.insert(i, i);
+    }
+    for (int i = 0; i < 100; i += 2) {
+        EXPECT_TRUE(colliding.erase(i));
+    }
+    for (int i = 0; i < 100; ++i) {
+        EXPECT_EQ(colliding.contains(i), i % 2 == 1) << i;
+    }
+    colliding.insert(200, 1);
+    EXPECT_EQ(colliding.size(), 51);
+    EXPECT_EQ(colliding.get(99)->get(), 99);
+}
+
+TEST_F(MyHashMapTest, ChurnDoesNotGrowTheTable) {
+    map.reserve(100);
+    std::size_t buckets = map.bucket_count();
+    for (int i = 0; i < 100'000; ++i) {
+        map.insert(i, i);
+        if (i >= 50) {
+            ASSERT_TRUE(map.erase(i - 50));
+        }
+    }
+    EXPECT_EQ(map.size(), 50);
+    EXPECT_EQ(map.bucket_count(), buckets);
+}
+
+TEST_F(MyHashMapTest, MatchesUnorderedMapUnderRandomOps) {
+    expectMatchesUnorderedMap<HashMap<std::string, int>>();
+}
+
+TEST_F(MyHashMapTest, ReserveRehashAndShrink) {
+    map.reserve(1000);
+    EXPECT_GE(map.bucket_count() * 7 / 8, 1000);
+    for (int i = 0; i < 20; ++i) {
+        map.insert(i, i);
+    }
+    map.shrink_to_fit();
+    EXPECT_EQ(map.bucket_count(), 32);
+    map.rehash(256);
+    EXPECT_EQ(map.bucket_count(), 256);
+    map.rehash(0);
+    EXPECT_EQ(map.bucket_count(), 32);
+    for (int i = 0; i < 20; ++i) {
+        EXPECT_EQ(map.get(i)->get(), i);
+    }
+}
+
+TEST_F(MyHashMapTest, CopyMoveAndEquality) {
+    HashMap<std::string, std::vector<int>> original;
+    for (int i = 0; i < 100; ++i) {
+        original.insert(std::to_string(i), std::vector<int>(i % 5, i));
+    }
+    original.erase("3");
+
+    HashMap<std::string, std::vector<int>> copy = original;
+    EXPECT_EQ(copy, original);
+    copy.insert("3", {});
+    EXPECT_NE(copy, original);
+
+    HashMap<std::string, std::vector<int>> moved = std::move(copy);
+    EXPECT_EQ(moved.size(), 100);
+    EXPECT_TRUE(copy.empty());
+    copy.insert("again", {1});
+    EXPECT_EQ(copy.get("again")->get(), std::vector<int>{1});
+
+    moved = original;
+    EXPECT_EQ(moved, original);
+}
+
+namespace {
+    // A key that counts how many times it is constructed, hashed and compared by its text.
+    struct CountedKey {
+        static inline int made = 0;
+        std::string text;
+
+        explicit CountedKey(std::string_view view) : text{view} { ++made; }
+        CountedKey(const CountedKey& other) : text{other.text} { ++made; }
+        CountedKey(CountedKey&&) noexcept = default;
+        CountedKey& operator=(const CountedKey&) = default;
+        CountedKey& operator=(CountedKey&&) noexcept = default;
+    };
+
+    struct CountedHash {
+        using is_transparent = void;
+        std::size_t operator()(std::string_view view) const noexcept { return std::hash<std::string_view>{}(view); }
+        std::size_t operator()(const CountedKey& key) const noexcept { return (*this)(key.text); }
+    };
+
+    struct CountedEqual {
+        using is_transparent = void;
+        bool operator()(const CountedKey& a, const CountedKey& b) const noexcept { return a.text == b.text; }
+        bool operator()(const CountedKey& a, std::string_view b) const noexcept { return a.text == b; }
+    };
+} // namespace
+
+TEST_F(MyHashMapTest, TransparentLookupBuildsNoKeys) {
+    HashMap<CountedKey, int, CountedHash, CountedEqual> routes;
+    routes.try_emplace(std::string_view{"/users"}, 1);
+    routes.try_emplace(std::string_view{"/orders"}, 2);
+    EXPECT_EQ(CountedKey::made, 2);
+
+    CountedKey::made = 0;
+    std::string_view path{"/users"};
+    EXPECT_TRUE(routes.contains(path));
+    EXPECT_FALSE(routes.contains(std::string_view{"/nope"}));
+    EXPECT_EQ(routes.get(path)->get(), 1);
+    EXPECT_EQ(routes.find(std::string_view{"/orders"})->value, 2);
+    EXPECT_FALSE(routes.try_emplace(path, 9).second);
+    routes[path] += 10;
+    EXPECT_TRUE(routes.erase(std::string_view{"/orders"}));
+    EXPECT_EQ(CountedKey::made, 0);
+    EXPECT_EQ(routes.get(path)->get(), 11);
+
+    routes[std::string_view{"/new"}] = 3;
+    EXPECT_EQ(CountedKey::made, 1);
+}
+
+TEST_F(MyHashMapTest, StringKeysLookUpByView) {
+    HashMap<String, int, StringHash, std::equal_to<>> map;
+    map.insert(String{"alpha"}, 1);
+    map.insert("beta", 2);
+    EXPECT_TRUE(map.contains(std::string_view{"alpha"}));
+    EXPECT_TRUE(map.contains("beta"));
+    EXPECT_TRUE(map.contains(String{"beta"}));
+    EXPECT_FALSE(map.contains("gamma"));
+    EXPECT_EQ(map.find("beta")->key, "beta");
+}
+
+TEST_F(MyHashMapTest, NonTransparentLookupConvertsToKey) {
+    HashMap<std::string, int> map;
+    map.insert("one", 1);
+    EXPECT_TRUE(map.contains("one"));
+    EXPECT_EQ(map.get(std::string_view{"one"}.data())->get(), 1);
+    EXPECT_TRUE(map.erase("one"));
+    EXPECT_TRUE(map.empty());
+}
+
+TEST_F(MyHashMapTest, TryEmplaceLeavesArgumentsWhenPresent) {
+    HashMap<int, std::unique_ptr<int>> owners;
+    auto first = std::make_unique<int>(1);
+    auto [it, inserted] = owners.try_emplace(1, std::move(first));
+    EXPECT_TRUE(inserted);
+    EXPECT_EQ(*it->value, 1);
+    EXPECT_EQ(first, nullptr);
+
+    auto second = std::make_unique<int>(2);
+    EXPECT_FALSE(owners.try_emplace(1, std::move(second)).second);
+    ASSERT_NE(second, nullptr);
+    EXPECT_FALSE(owners.emplace(1, std::move(second)).second);
+    EXPECT_NE(second, nullptr);
+    EXPECT_EQ(*owners.get(1)->get(), 1);
+}
+
+TEST_F(MyHashMapTest, TryEmplaceConstructsValueInPlace) {
+    HashMap<int, std::vector<int>> map;
+    auto [it, inserted] = map.try_emplace(4, 3, 7);
+    EXPECT_TRUE(inserted);
+    EXPECT_EQ(it->value, (std::vector<int>{7, 7, 7}));
+}
+
+TEST_F(MyHashMapTest, InsertOrAssignReportsInsertion) {
+    auto [it, inserted] = map.insert_or_assign(1, 10);
+    EXPECT_TRUE(inserted);
+    EXPECT_EQ(it->key, 1);
+    auto [again, insertedAgain] = map.insert_or_assign(1, 20);
+    EXPECT_FALSE(insertedAgain);
+    EXPECT_EQ(again, it);
+    EXPECT_EQ(map.get(1)->get(), 20);
+    EXPECT_EQ(map.size(), 1);
+}
+
+TEST_F(MyHashMapTest, IteratesEveryElementOnce) {
+    static_assert(std::forward_iterator<HashMap<int, int>::iterator>);
+    static_assert(std::forward_iterator<HashMap<int, int>::const_iterator>);
+    EXPECT_EQ(map.begin(), map.end());
+    for (int i = 0; i < 500; ++i) {
+        map.insert(i, i);
+    }
+    long sum = 0;
+    std::size_t count = 0;
+    for (auto& [key, value]: map) {
+        value *= 2;
+        sum += key;
+        ++count;
+    }
+    EXPECT_EQ(count, 500);
+    EXPECT_EQ(sum, 499 * 500 / 2);
+    const auto& constMap = map;
+    HashMap<int, int>::const_iterator found = map.find(7);
+    EXPECT_EQ(found, constMap.find(7));
+    EXPECT_EQ(found->value, 14);
+    EXPECT_EQ(constMap.find(1000), constMap.end());
+}
+
+TEST_F(MyHashMapTest, EraseWhileIterating) {
+    for (int i = 0; i < 300; ++i) {
+        map.insert(i, i);
+    }
+    for (auto it = map.begin(); it != map.end();) {
+        it = it->key % 3 == 0 ? map.erase(it) : std::next(it);
+    }
+    EXPECT_EQ(map.size(), 200);
+    for (int i = 0; i < 300; ++i) {
+        EXPECT_EQ(map.contains(i), i % 3 != 0);
+    }
+}
+
+TEST_F(MyHashMapTest, IncrementalRehashKeepsOldTableUntilDrained) {
+    IncrementalMap inc(1024);
+    for (int i = 0; i < 896; ++i) {
+        inc.insert(i, i);
+    }
+    EXPECT_FALSE(inc.rehashing());
+    inc.insert(896, 896);
+    EXPECT_TRUE(inc.rehashing());
+    EXPECT_EQ(inc.bucket_count(), 2048);
+    EXPECT_EQ(inc.size(), 897);
+    for (int i = 0; i <= 896; ++i) {
+        ASSERT_EQ(inc.get(i)->get(), i) << i;
+    }
+    EXPECT_EQ(static_cast<std::size_t>(std::distance(inc.begin(), inc.end())), 897);
+
+    // Two groups per insert drain 1024 old slots within 32 more inserts.
+    for (int i = 897; i < 897 + 32; ++i) {
+        inc.insert(i, i);
+    }
+    EXPECT_FALSE(inc.rehashing());
+    for (int i = 0; i < 897 + 32; ++i) {
+        ASSERT_TRUE(inc.contains(i)) << i;
+    }
+}
+
+TEST_F(MyHashMapTest, IncrementalRehashEraseAndCopyMidway) {
+    IncrementalMap inc(256);
+    for (int i = 0; i < 230; ++i) {
+        inc.insert(i, i);
+    }
+    // The rehash started at the 225th insert and takes eight inserts to drain 256 slots.
+    ASSERT_TRUE(inc.rehashing());
+    IncrementalMap copy = inc;
+    EXPECT_TRUE(copy.rehashing());
+    EXPECT_EQ(copy, inc);
+
+    for (int i = 0; i < 230; i += 2) {
+        ASSERT_TRUE(inc.erase(i));
+    }
+    for (auto it = inc.begin(); it != inc.end();) {
+        it = it->key % 3 == 0 ? inc.erase(it) : std::next(it);
+    }
+    for (int i = 0; i < 230; ++i) {
+        EXPECT_EQ(inc.contains(i), i % 2 == 1 && i % 3 != 0) << i;
+        EXPECT_TRUE(copy.contains(i));
+    }
+    EXPECT_EQ(inc.size(), 77);
+
+    while (copy.rehashStep(1)) {
+    }
+    EXPECT_FALSE(copy.rehashing());
+    EXPECT_EQ(copy.size(), 230);
+    copy.rehash(0);
+    EXPECT_EQ(copy.bucket_count(), 512);
+}
+
+TEST_F(MyHashMapTest, IncrementalMatchesUnorderedMapUnderRandomOps) {
+    expectMatchesUnorderedMap<HashMap<std::string, int, std::hash<std::string>, std::equal_to<std::string>,
+                                      RehashIncremental>>();
+}
+
+TEST_F(MyHashMapTest, GetManyMatchesGet) {
+    for (int i = 0; i < 3000; i += 2) {
+        map.insert(i, i * 10);
+    }
+    // Not a multiple of the internal batch size, so the last batch is partial.
+    std::vector<int> keys;
+    for (int i = 0; i < 1001; ++i) {
+        keys.push_back((i * 7919) % 3000);
+    }
+    std::vector<int*> values(keys.size());
+    EXPECT_EQ(map.getMany(keys, values), 501);
+    for (std::size_t i = 0; i < keys.size(); ++i) {
+        auto expected = map.get(keys[i]);
+        ASSERT_EQ(values[i] != nullptr, expected.has_value()) << keys[i];
+        if (values[i]) {
+            EXPECT_EQ(values[i], &expected->get());
+            ++*values[i];
+        }
+    }
+    EXPECT_EQ(map.get(0)->get(), 1);
+
+    std::unique_ptr<bool[]> present{new bool[keys.size()]};
+    EXPECT_EQ(map.containsMany(keys, {present.get(), keys.size()}), 501);
+    for (std::size_t i = 0; i < keys.size(); ++i) {
+        EXPECT_EQ(present[i], keys[i] % 2 == 0) << keys[i];
+    }
+}
+
+TEST_F(MyHashMapTest, GetManyFollowsLongProbesAndTheOldTable) {
+    HashMap<int, int, CollidingHash> colliding;
+    IncrementalMap inc(256);
+    for (int i = 0; i < 230; ++i) {
+        colliding.insert(i, i);
+        inc.insert(i, i);
+    }
+    ASSERT_TRUE(inc.rehashing());
+    std::vector<int> keys;
+    for (int i = 0; i < 300; ++i) {
+        keys.push_back(i);
+    }
+    std::vector<const int*> values(keys.size());
+    const auto& constColliding = colliding;
+    EXPECT_EQ(constColliding.getMany(keys, values), 230);
+    for (int i = 0; i < 300; ++i) {
+        EXPECT_EQ(values[i] ? *values[i] : -1, i < 230 ? i : -1) << i;
+    }
+    std::vector<int*> incValues(keys.size());
+    EXPECT_EQ(inc.getMany(keys, incValues), 230);
+    for (int i = 0; i < 300; ++i) {
+        EXPECT_EQ(incValues[i] ? *incValues[i] : -1, i < 230 ? i : -1) << i;
+    }
+}
+
+TEST_F(MyHashMapTest, GetManyChecksTheOutputLength) {
+    std::vector<int> keys{1, 2, 3};
+    int stale = 0;
+    std::vector<int*> values(3, &stale);
+    EXPECT_EQ(map.getMany(keys, values), 0);
+    EXPECT_EQ(values, (std::vector<int*>(3, nullptr)));
+    values.pop_back();
+    EXPECT_THROW(map.getMany(keys, values), std::invalid_argument);
+}
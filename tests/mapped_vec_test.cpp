@@ -0,0 +1,113 @@
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <gtest/gtest.h>
+#include <vector>
+#include "../src/vector/my_mapped_vec.hpp"
+
+namespace {
+    struct Record {
+        std::uint32_t id;
+        float score;
+
+        bool operator==(const Record&) const = default;
+    };
+} // namespace
+
+class MyMappedVecTest : public testing::Test {
+protected:
+    std::filesystem::path path =
+        std::filesystem::temp_directory_path() /
+        ("ds_mapped_vec_" + std::to_string(::getpid()) + "_" +
+         testing::UnitTest::GetInstance()->current_test_info()->name() + ".bin");
+
+    void TearDown() override { std::filesystem::remove(path); }
+};
+
+TEST_F(MyMappedVecTest, CreatesEmptyFile) {
+    MappedVector<Record> vec(path);
+    EXPECT_EQ(vec.size(), 0);
+    EXPECT_TRUE(vec.empty());
+    EXPECT_TRUE(std::filesystem::exists(path));
+}
+
+TEST_F(MyMappedVecTest, PushBackAndReopen) {
+    {
+        MappedVector<Record> vec(path);
+        for (std::uint32_t i = 0; i < 1000; ++i) {
+            vec.pushBack(Record{i, static_cast<float>(i) / 2});
+        }
+        EXPECT_EQ(vec.size(), 1000);
+        EXPECT_GE(vec.capacity(), 1000);
+    }
+    MappedVector<Record> reopened(path);
+    EXPECT_EQ(reopened.size(), 1000);
+    EXPECT_EQ(reopened[999], (Record{999, 499.5f}));
+    EXPECT_EQ(reopened.front(), (Record{0, 0.0f}));
+}
+
+TEST_F(MyMappedVecTest, ShrinkToFitTruncatesFile) {
+    MappedVector<std::uint64_t> vec(path);
+    vec.resize(100, 7);
+    vec.reserve(5000);
+    vec.shrinkToFit();
+    EXPECT_EQ(vec.capacity(), 100);
+    EXPECT_EQ(std::filesystem::file_size(path), MappedVector<std::uint64_t>::headerSize + 100 * sizeof(std::uint64_t));
+    EXPECT_EQ(vec[99], 7);
+}
+
+TEST_F(MyMappedVecTest, RejectsMismatchedElementSize) {
+    {
+        MappedVector<std::uint32_t> vec(path);
+        vec.pushBack(1);
+    }
+    EXPECT_THROW(MappedVector<std::uint64_t>{path}, std::runtime_error);
+}
+
+TEST_F(MyMappedVecTest, RejectsForeignFile) {
+    {
+        std::ofstream out(path, std::ios::binary);
+        out << std::string(128, 'z');
+    }
+    EXPECT_THROW(MappedVector<std::uint32_t>{path}, std::runtime_error);
+}
+
+TEST_F(MyMappedVecTest, EraseAppendAndAdvise) {
+    MappedVector<int> vec(path);
+    std::vector<int> src{1, 2, 3, 2, 1};
+    vec.appendRange(src);
+    vec.erase(2);
+    EXPECT_EQ(std::vector<int>(vec.begin(), vec.end()), (std::vector<int>{1, 3, 1}));
+    EXPECT_NO_THROW(vec.advise(MappedVector<int>::Access::Sequential));
+    EXPECT_NO_THROW(vec.advise(MappedVector<int>::Access::Random));
+    EXPECT_NO_THROW(vec.sync());
+    vec.popBack();
+    EXPECT_EQ(vec.size(), 2);
+    EXPECT_THROW(vec.at(2), std::out_of_range);
+}
+
+TEST_F(MyMappedVecTest, MoveTransfersMapping) {
+    MappedVector<int> vec(path);
+    vec.pushBack(42);
+    MappedVector<int> moved(std::move(vec));
+    EXPECT_EQ(moved.size(), 1);
+    EXPECT_EQ(moved[0], 42);
+    EXPECT_EQ(vec.size(), 0);
+    EXPECT_TRUE(vec.empty());
+    EXPECT_EQ(vec.capacity(), 0);
+    EXPECT_EQ(vec.begin(), vec.end());
+    vec.clear();
+    vec.erase(42);
+    vec.assign(0, 7);
+    vec.popBack();
+    EXPECT_TRUE(vec.empty());
+
+    MappedVector<int> assigned(path.string() + ".other");
+    assigned = std::move(moved);
+    EXPECT_EQ(assigned[0], 42);
+    EXPECT_TRUE(moved.empty());
+    EXPECT_EQ(moved.capacity(), 0);
+    moved.clear();
+    EXPECT_TRUE(moved.empty());
+    std::filesystem::remove(path.string() + ".other");
+}
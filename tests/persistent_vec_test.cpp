@@ -0,0 +1,199 @@
+#include <gtest/gtest.h>
+#include <atomic>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+#include "../src/vector/my_persistent_vec.hpp"
+#include "../src/vector/my_vec.hpp"
+
+class MyPersistentVecTest : public testing::Test {
+protected:
+    static PersistentVector<int> iota(int n) {
+        auto tr = PersistentVector<int>{}.transient();
+        for (int i = 0; i < n; ++i) {
+            tr.pushBack(i);
+        }
+        return std::move(tr).persistent();
+    }
+};
+
+TEST_F(MyPersistentVecTest, DefaultIsEmpty) {
+    PersistentVector<int> vec;
+    EXPECT_TRUE(vec.empty());
+    EXPECT_EQ(vec.size(), 0);
+    EXPECT_EQ(vec.begin(), vec.end());
+}
+
+TEST_F(MyPersistentVecTest, PushBackLeavesOriginalUntouched) {
+    PersistentVector<int> a{1, 2, 3};
+    auto b = a.pushBack(4);
+    EXPECT_EQ(a.size(), 3);
+    EXPECT_EQ(b.size(), 4);
+    EXPECT_EQ(b.back(), 4);
+    EXPECT_EQ(a.back(), 3);
+}
+
+// Crosses the tail boundary and several trie levels (32, 32^2 and 32^3 elements).
+TEST_F(MyPersistentVecTest, IndexAcrossLevels) {
+    const int n = 40'000;
+    PersistentVector<int> vec;
+    for (int i = 0; i < n; ++i) {
+        vec = std::move(vec).pushBack(i);
+    }
+    ASSERT_EQ(vec.size(), n);
+    for (int i = 0; i < n; ++i) {
+        ASSERT_EQ(vec[i], i);
+    }
+    EXPECT_THROW(static_cast<void>(vec.at(n)), std::out_of_range);
+}
+
+TEST_F(MyPersistentVecTest, UpdateCopiesPathOnly) {
+    auto a = iota(5000);
+    auto b = a.update(10, -1).update(4999, -2);
+    EXPECT_EQ(a[10], 10);
+    EXPECT_EQ(a[4999], 4999);
+    EXPECT_EQ(b[10], -1);
+    EXPECT_EQ(b[4999], -2);
+    EXPECT_EQ(b[11], 11);
+    EXPECT_FALSE(a == b);
+    EXPECT_THROW(static_cast<void>(a.update(5000, 0)), std::out_of_range);
+}
+
+TEST_F(MyPersistentVecTest, SnapshotsAreIndependent) {
+    std::vector<PersistentVector<int>> snapshots;
+    PersistentVector<int> vec;
+    for (int i = 0; i < 1100; ++i) {
+        snapshots.push_back(vec);
+        vec = vec.pushBack(i);
+    }
+    for (int s = 0; s < 1100; s += 37) {
+        ASSERT_EQ(snapshots[s].size(), static_cast<std::size_t>(s));
+        for (int i = 0; i < s; ++i) {
+            ASSERT_EQ(snapshots[s][i], i);
+        }
+    }
+}
+
+TEST_F(MyPersistentVecTest, TransientDoesNotDisturbSource) {
+    auto base = iota(3000);
+    auto tr = base.transient();
+    for (int i = 0; i < 3000; i += 2) {
+        tr.update(i, -i);
+    }
+    tr.pushBack(3000);
+    auto edited = std::move(tr).persistent();
+
+    EXPECT_EQ(edited.size(), 3001);
+    EXPECT_EQ(base.size(), 3000);
+    for (int i = 0; i < 3000; ++i) {
+        ASSERT_EQ(base[i], i);
+        ASSERT_EQ(edited[i], i % 2 == 0 ? -i : i);
+    }
+}
+
+TEST_F(MyPersistentVecTest, NonTrivialElements) {
+    PersistentVector<std::string> vec;
+    for (int i = 0; i < 100; ++i) {
+        vec = vec.pushBack(std::string(20, static_cast<char>('a' + i % 26)));
+    }
+    auto other = vec.update(50, "changed");
+    EXPECT_EQ(vec[50], std::string(20, static_cast<char>('a' + 50 % 26)));
+    EXPECT_EQ(other[50], "changed");
+    EXPECT_EQ(other[99], vec[99]);
+}
+
+TEST_F(MyPersistentVecTest, ConvertsToAndFromVector) {
+    Vector<int> source;
+    for (int i = 0; i < 1000; ++i) {
+        source.pushBack(i * 3);
+    }
+    PersistentVector<int> vec{source};
+    ASSERT_EQ(vec.size(), source.size());
+
+    Vector<int> back = vec.toVector();
+    ASSERT_EQ(back.size(), source.size());
+    for (std::size_t i = 0; i < source.size(); ++i) {
+        ASSERT_EQ(back[i], source[i]);
+    }
+    EXPECT_TRUE(std::equal(vec.begin(), vec.end(), source.begin()));
+}
+
+TEST_F(MyPersistentVecTest, ConcurrentReadersOfSharedSnapshot) {
+    auto snapshot = iota(10'000);
+    std::vector<std::thread> readers;
+    std::vector<long> sums(4);
+    for (std::size_t t = 0; t < sums.size(); ++t) {
+        readers.emplace_back([snapshot, &sums, t] {
+            auto local = snapshot.pushBack(1);
+            long sum = 0;
+            for (int x: local) {
+                sum += x;
+            }
+            sums[t] = sum;
+        });
+    }
+    for (auto& reader: readers) {
+        reader.join();
+    }
+    for (long sum: sums) {
+        EXPECT_EQ(sum, 10'000L * 9'999 / 2 + 1);
+    }
+}
+
+namespace {
+    // Counts live instances, to catch nodes that are never freed.
+    struct Counted {
+        static inline std::atomic<int> live{0};
+        int value;
+
+        Counted(int v) : value{v} { ++live; }
+        Counted(const Counted& other) : value{other.value} { ++live; }
+        Counted& operator=(const Counted&) = default;
+        ~Counted() { --live; }
+    };
+} // namespace
+
+// The writer copies shared nodes while other threads drop the snapshots that share them; whichever
+// side lets go last must free each node.
+TEST_F(MyPersistentVecTest, WriterAndDroppedSnapshotsFreeEveryNode) {
+    {
+        std::mutex mutex;
+        std::vector<PersistentVector<Counted>> pending;
+        std::atomic<bool> done{false};
+        std::vector<std::thread> droppers;
+        for (int t = 0; t < 3; ++t) {
+            droppers.emplace_back([&] {
+                while (!done.load()) {
+                    std::vector<PersistentVector<Counted>> taken;
+                    {
+                        std::lock_guard lock{mutex};
+                        taken.swap(pending);
+                    }
+                    taken.clear();
+                }
+            });
+        }
+
+        PersistentVector<Counted> vec;
+        for (int i = 0; i < 20'000; ++i) {
+            {
+                std::lock_guard lock{mutex};
+                pending.push_back(vec);
+            }
+            vec = std::move(vec).pushBack(Counted{i});
+            if (i % 7 == 0) {
+                vec = std::move(vec).update(static_cast<std::size_t>(i / 2), Counted{-i});
+            }
+        }
+        done = true;
+        for (auto& dropper: droppers) {
+            dropper.join();
+        }
+        pending.clear();
+        ASSERT_EQ(vec.size(), 20'000);
+        EXPECT_EQ(vec[19'999].value, 19'999);
+    }
+    EXPECT_EQ(Counted::live.load(), 0);
+}
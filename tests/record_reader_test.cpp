@@ -0,0 +1,134 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <atomic>
+#include <filesystem>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unistd.h>
+#include <vector>
+#include "../src/string/record_reader.hpp"
+
+class MyRecordReaderTest : public testing::Test {
+protected:
+    std::filesystem::path path =
+        std::filesystem::temp_directory_path() / ("record_reader_test_" + std::to_string(::getpid()) + ".txt");
+
+    void TearDown() override { std::filesystem::remove(path); }
+
+    void write(std::string_view contents) {
+        std::ofstream out(path, std::ios::binary | std::ios::trunc);
+        out.write(contents.data(), static_cast<std::streamsize>(contents.size()));
+    }
+
+    static std::vector<std::string> collect(const RecordReader& reader) {
+        std::vector<std::string> records;
+        reader.for_each([&](std::string_view record) { records.emplace_back(record); });
+        return records;
+    }
+
+    static std::vector<RecordReader::Options> allBackends(char delim = '\n') {
+        // A 4-byte block forces records across block boundaries and buffer growth.
+        return {{delim, RecordReader::Backend::Map, 1 << 20},
+                {delim, RecordReader::Backend::Read, 1 << 20},
+                {delim, RecordReader::Backend::Read, 4}};
+    }
+};
+
+TEST_F(MyRecordReaderTest, ReadsLinesWithAndWithoutTrailingDelimiter) {
+    for (std::string_view contents: {"alpha\nbeta\n\ngamma\n", "alpha\nbeta\n\ngamma"}) {
+        write(contents);
+        for (auto options: allBackends()) {
+            RecordReader reader(path, options);
+            EXPECT_EQ(reader.mapped(), options.backend == RecordReader::Backend::Map);
+            EXPECT_EQ(collect(reader), (std::vector<std::string>{"alpha", "beta", "", "gamma"}));
+        }
+    }
+}
+
+TEST_F(MyRecordReaderTest, EmptyFileHasNoRecords) {
+    write("");
+    for (auto options: allBackends()) {
+        RecordReader reader(path, options);
+        EXPECT_EQ(reader.file_size(), 0);
+        EXPECT_TRUE(collect(reader).empty());
+    }
+}
+
+TEST_F(MyRecordReaderTest, RecordsLongerThanTheBlock) {
+    std::string longRecord(1000, 'x');
+    write("ab|" + longRecord + "|cd|");
+    for (auto options: allBackends('|')) {
+        RecordReader reader(path, options);
+        EXPECT_EQ(collect(reader), (std::vector<std::string>{"ab", longRecord, "cd"}));
+    }
+}
+
+TEST_F(MyRecordReaderTest, ParallelSeesEveryRecordOnce) {
+    std::string contents;
+    std::vector<std::string> expected;
+    for (int i = 0; i < 5000; ++i) {
+        expected.push_back("record-" + std::to_string(i) + std::string(i % 37, 'z'));
+        contents += expected.back() + '\n';
+    }
+    write(contents);
+    for (auto options: allBackends()) {
+        for (std::size_t threads: {1, 2, 3, 8}) {
+            RecordReader reader(path, options);
+            std::mutex mutex;
+            std::vector<std::string> seen;
+            std::atomic<std::size_t> maxWorker{0};
+            reader.for_each_parallel(threads, [&](std::string_view record, std::size_t worker) {
+                std::size_t prev = maxWorker.load();
+                while (worker > prev && !maxWorker.compare_exchange_weak(prev, worker)) {
+                }
+                std::lock_guard lock{mutex};
+                seen.emplace_back(record);
+            });
+            std::sort(seen.begin(), seen.end());
+            std::vector<std::string> sorted = expected;
+            std::sort(sorted.begin(), sorted.end());
+            EXPECT_EQ(seen, sorted);
+            EXPECT_LT(maxWorker.load(), threads);
+        }
+    }
+}
+
+TEST_F(MyRecordReaderTest, ParallelSplitsRightAfterADelimiter) {
+    // With two workers the split lands at byte 2, exactly where the second record starts.
+    write("a\nb\n");
+    RecordReader reader(path);
+    std::mutex mutex;
+    std::vector<std::string> seen;
+    reader.for_each_parallel(2, [&](std::string_view record, std::size_t) {
+        std::lock_guard lock{mutex};
+        seen.emplace_back(record);
+    });
+    std::sort(seen.begin(), seen.end());
+    EXPECT_EQ(seen, (std::vector<std::string>{"a", "b"}));
+}
+
+TEST_F(MyRecordReaderTest, ToStringsCopiesRecords) {
+    write("key=value\nlonger_key_that_goes_to_the_heap=another value\n");
+    std::vector<String> records = RecordReader(path).to_strings();
+    ASSERT_EQ(records.size(), 2);
+    EXPECT_EQ(records[0], "key=value");
+    EXPECT_EQ(records[1], "longer_key_that_goes_to_the_heap=another value");
+}
+
+TEST_F(MyRecordReaderTest, ParallelRethrowsWorkerException) {
+    write("one\ntwo\nthree\nfour\n");
+    RecordReader reader(path);
+    EXPECT_THROW(reader.for_each_parallel(2,
+                                          [](std::string_view record, std::size_t) {
+                                              if (record == "three") {
+                                                  throw std::runtime_error{"bad record"};
+                                              }
+                                          }),
+                 std::runtime_error);
+}
+
+TEST_F(MyRecordReaderTest, MissingFileThrows) {
+    EXPECT_THROW(RecordReader{path / "missing"}, std::system_error);
+}
@@ -0,0 +1,159 @@
+#include <gtest/gtest.h>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include "../src/string/my_rope.hpp"
+
+class MyRopeTest : public testing::Test {
+protected:
+    static std::string text(const Rope& rope) {
+        String flat = rope.flatten();
+        return std::string{flat.data(), flat.size()};
+    }
+
+    static std::string chunked(const Rope& rope) {
+        std::string out;
+        for (std::string_view chunk: rope.chunks()) {
+            out += chunk;
+        }
+        return out;
+    }
+
+    // Builds a rope from count fragments of len characters cycling through the alphabet.
+    static std::pair<Rope, std::string> fragments(std::size_t count, std::size_t len) {
+        Rope rope;
+        std::string expected;
+        for (std::size_t i = 0; i < count; ++i) {
+            std::string piece(len, static_cast<char>('a' + i % 26));
+            rope += Rope{piece};
+            expected += piece;
+        }
+        return {rope, expected};
+    }
+};
+
+TEST_F(MyRopeTest, EmptyRope) {
+    Rope rope;
+    EXPECT_TRUE(rope.empty());
+    EXPECT_EQ(rope.size(), 0);
+    EXPECT_EQ(rope.chunks().begin(), rope.chunks().end());
+    EXPECT_EQ(text(rope), "");
+    EXPECT_TRUE(Rope{""}.empty());
+}
+
+TEST_F(MyRopeTest, ConcatKeepsOperands) {
+    Rope hello{"Hello, "};
+    Rope world{"World!"};
+    Rope both = hello + world;
+    EXPECT_EQ(text(both), "Hello, World!");
+    EXPECT_EQ(text(hello), "Hello, ");
+    EXPECT_EQ(text(world), "World!");
+}
+
+TEST_F(MyRopeTest, SmallFragmentsAreMerged) {
+    auto [rope, expected] = fragments(64, 4);
+    EXPECT_EQ(rope.size(), expected.size());
+    EXPECT_EQ(text(rope), expected);
+    EXPECT_EQ(std::ranges::distance(rope.chunks()), 1);
+}
+
+TEST_F(MyRopeTest, LargeFragmentsStayBalanced) {
+    auto [rope, expected] = fragments(10'000, 600);
+    EXPECT_EQ(rope.size(), expected.size());
+    EXPECT_EQ(chunked(rope), expected);
+    EXPECT_EQ(std::ranges::distance(rope.chunks()), 10'000);
+    // An AVL tree over 10'000 leaves is at most 1.44 * log2(10'000) ~ 19 levels deep.
+    EXPECT_LE(rope.height(), 20);
+}
+
+TEST_F(MyRopeTest, IndexAndAt) {
+    auto [rope, expected] = fragments(500, 700);
+    for (std::size_t i = 0; i < expected.size(); i += 97) {
+        ASSERT_EQ(rope[i], expected[i]);
+    }
+    EXPECT_EQ(rope.at(expected.size() - 1), expected.back());
+    EXPECT_THROW(static_cast<void>(rope.at(expected.size())), std::out_of_range);
+}
+
+TEST_F(MyRopeTest, Substr) {
+    auto [rope, expected] = fragments(300, 600);
+    for (std::size_t pos: {0UL, 1UL, 599UL, 600UL, 12'345UL, 179'000UL}) {
+        for (std::size_t len: {0UL, 1UL, 1000UL, 50'000UL}) {
+            Rope sub = rope.substr(pos, len);
+            ASSERT_EQ(text(sub), expected.substr(pos, len)) << pos << " " << len;
+        }
+    }
+    EXPECT_EQ(text(rope.substr(expected.size())), "");
+    EXPECT_THROW(static_cast<void>(rope.substr(expected.size() + 1)), std::out_of_range);
+}
+
+TEST_F(MyRopeTest, SubstrOfSubstrAndReassembly) {
+    auto [rope, expected] = fragments(200, 1000);
+    Rope middle = rope.substr(1500, 100'000).substr(250, 50'000);
+    EXPECT_EQ(text(middle), expected.substr(1750, 50'000));
+
+    Rope reassembled = rope.substr(0, 77'777) + rope.substr(77'777);
+    EXPECT_EQ(text(reassembled), expected);
+    EXPECT_LE(reassembled.height(), 20);
+}
+
+TEST_F(MyRopeTest, BuilderPacksFragmentsAndLinksRopes) {
+    Rope::Builder builder;
+    std::string expected;
+    for (int i = 0; i < 5000; ++i) {
+        std::string piece(1 + i % 90, static_cast<char>('a' + i % 26));
+        builder.append(std::string_view{piece});
+        expected += piece;
+    }
+    auto [linked, linkedText] = fragments(50, 600);
+    builder.append(linked);
+    expected += linkedText;
+    std::string big(Rope::CHUNK_LEN + 1, 'Z');
+    builder.append(std::string_view{big});
+    expected += big;
+
+    Rope rope = std::move(builder).build();
+    EXPECT_EQ(rope.size(), expected.size());
+    EXPECT_EQ(chunked(rope), expected);
+    EXPECT_EQ(text(rope.substr(100'000, 5000)), expected.substr(100'000, 5000));
+    for (std::string_view chunk: rope.chunks()) {
+        EXPECT_LE(chunk.size(), big.size());
+    }
+    EXPECT_TRUE(std::move(Rope::Builder{}).build().empty());
+}
+
+// Concatenating a rope with itself links the same subtree on both sides of a node.
+TEST_F(MyRopeTest, ConcatWithItselfSharesSubtrees) {
+    std::string piece(600, 'a');
+    piece[0] = 'x';
+    piece[599] = 'y';
+    Rope a{piece};
+
+    Rope twice = a + a;
+    EXPECT_EQ(twice.size(), 1200);
+    EXPECT_EQ(text(twice), piece + piece);
+    EXPECT_EQ(chunked(twice), piece + piece);
+    EXPECT_EQ(text(twice + twice), piece + piece + piece + piece);
+
+    Rope grown = a;
+    grown += grown;
+    grown += grown.substr(300, 600);
+    EXPECT_EQ(text(grown), piece + piece + (piece + piece).substr(300, 600));
+
+    Rope::Builder builder;
+    builder.append(a).append(a).append(twice);
+    EXPECT_EQ(chunked(std::move(builder).build()), piece + piece + piece + piece);
+}
+
+TEST_F(MyRopeTest, ChunkIteratorsAtSharedLeavesDiffer) {
+    Rope a{std::string(600, 'a')};
+    Rope twice = a + a;
+    auto chunks = twice.chunks();
+    auto first = chunks.begin();
+    auto second = std::next(first);
+    EXPECT_EQ(*first, *second);
+    EXPECT_NE(first, second);
+    EXPECT_EQ(first, chunks.begin());
+    EXPECT_NE(second, std::ranges::iterator_t<decltype(chunks)>{});
+    EXPECT_EQ(std::next(second), chunks.end());
+}
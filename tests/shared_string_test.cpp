@@ -0,0 +1,108 @@
+#include <gtest/gtest.h>
+#include <string>
+#include <thread>
+#include <unordered_set>
+#include <vector>
+#include "../src/string/shared_string.hpp"
+
+class MySharedStringTest : public testing::Test {
+protected:
+    std::string payload = std::string(1000, 'p') + "-end";
+};
+
+TEST_F(MySharedStringTest, DefaultIsEmpty) {
+    SharedString str;
+    EXPECT_TRUE(str.empty());
+    EXPECT_EQ(str.use_count(), 0);
+    EXPECT_EQ(str.view(), "");
+}
+
+TEST_F(MySharedStringTest, CopiesShareTheBuffer) {
+    SharedString original(std::string_view{payload});
+    SharedString copy = original;
+    EXPECT_EQ(copy.data(), original.data());
+    EXPECT_EQ(original.use_count(), 2);
+    {
+        std::vector<SharedString> fanOut(10, original);
+        EXPECT_EQ(original.use_count(), 12);
+    }
+    EXPECT_EQ(original.use_count(), 2);
+    EXPECT_EQ(copy, std::string_view{payload});
+}
+
+TEST_F(MySharedStringTest, SubstrSharesTheBuffer) {
+    SharedString original(std::string_view{payload});
+    SharedString tail = original.substr(1000);
+    EXPECT_EQ(tail, "-end");
+    EXPECT_EQ(tail.data(), original.data() + 1000);
+    EXPECT_EQ(original.use_count(), 2);
+    EXPECT_EQ(original.substr(2, 3), "ppp");
+    EXPECT_EQ(original.substr(original.size()), "");
+    EXPECT_THROW((void)original.substr(original.size() + 1), std::out_of_range);
+
+    // The substring keeps the buffer alive after the original is gone.
+    original = SharedString{};
+    EXPECT_EQ(tail.use_count(), 1);
+    EXPECT_EQ(tail, "-end");
+}
+
+TEST_F(MySharedStringTest, AppendCopiesOnWriteWhenShared) {
+    SharedString original("header:");
+    SharedString copy = original;
+    copy += "value";
+    EXPECT_EQ(original, "header:");
+    EXPECT_EQ(copy, "header:value");
+    EXPECT_NE(copy.data(), original.data());
+    EXPECT_EQ(original.use_count(), 1);
+    EXPECT_EQ(copy.use_count(), 1);
+
+    SharedString prefix = copy.substr(0, 6);
+    prefix += '!';
+    EXPECT_EQ(prefix, "header!");
+    EXPECT_EQ(copy, "header:value");
+}
+
+TEST_F(MySharedStringTest, AppendWritesInPlaceWhenUnique) {
+    // The first append reallocates with doubled capacity, so the next one fits in place.
+    SharedString str("abc");
+    str += "d";
+    const char* after = str.data();
+    str += "ef";
+    EXPECT_EQ(str.data(), after);
+    EXPECT_EQ(str, "abcdef");
+
+    SharedString self("xy");
+    self += self;
+    self += self.substr(1, 2);
+    EXPECT_EQ(self, "xyxyyx");
+}
+
+TEST_F(MySharedStringTest, ConvertsHashesAndCompares) {
+    SharedString shared(std::string_view{payload});
+    String owned = shared.to_string();
+    EXPECT_EQ(owned, String(payload.c_str()));
+    EXPECT_EQ(shared.hash(), owned.hash());
+    EXPECT_EQ(SharedString(owned), shared);
+    EXPECT_LT(SharedString("abc"), SharedString("abd"));
+
+    std::unordered_set<SharedString> set{shared, shared.substr(0), SharedString("other")};
+    EXPECT_EQ(set.size(), 2);
+}
+
+TEST_F(MySharedStringTest, ConcurrentCopiesAndDrops) {
+    SharedString original(std::string_view{payload});
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t) {
+        threads.emplace_back([&] {
+            for (int i = 0; i < 10000; ++i) {
+                SharedString copy = original;
+                SharedString piece = copy.substr(static_cast<std::size_t>(i % 100), 10);
+                ASSERT_EQ(piece.size(), 10);
+            }
+        });
+    }
+    for (auto& thread: threads) {
+        thread.join();
+    }
+    EXPECT_EQ(original.use_count(), 1);
+}
@@ -0,0 +1,83 @@
+#include <cmath>
+#include <cstdint>
+#include <gtest/gtest.h>
+#include <limits>
+#include <random>
+#include <vector>
+#include "../src/simd/simd_find.hpp"
+
+namespace {
+    enum class Color : std::uint16_t { Red, Green, Blue };
+
+    template<typename T>
+    std::vector<T> randomValues(std::size_t n, std::mt19937& rng) {
+        std::uniform_int_distribution<int> dist(0, 7);
+        std::vector<T> values(n);
+        for (auto& v: values) {
+            v = static_cast<T>(dist(rng));
+        }
+        return values;
+    }
+
+    // Checks find, count and remove against the scalar kernels for every length up to 130, so
+    // both the vector loops and their scalar tails are covered.
+    template<typename T>
+    void checkAgainstScalar() {
+        std::mt19937 rng{42};
+        for (std::size_t n = 0; n < 130; ++n) {
+            auto values = randomValues<T>(n, rng);
+            for (int needle = 0; needle < 9; ++needle) {
+                T value = static_cast<T>(needle);
+                EXPECT_EQ(simdFind(values.data(), n, value), ScalarSearch::find(values.data(), n, value));
+                EXPECT_EQ(simdCount(values.data(), n, value), ScalarSearch::count(values.data(), n, value));
+
+                auto expected = values;
+                expected.resize(ScalarSearch::remove(expected.data(), 0, n, value));
+                auto actual = values;
+                actual.resize(simdRemove(actual.data(), n, value));
+                EXPECT_EQ(actual, expected);
+            }
+        }
+    }
+} // namespace
+
+TEST(SimdFindTest, Int8) { checkAgainstScalar<std::int8_t>(); }
+TEST(SimdFindTest, UInt16) { checkAgainstScalar<std::uint16_t>(); }
+TEST(SimdFindTest, Int32) { checkAgainstScalar<std::int32_t>(); }
+TEST(SimdFindTest, UInt64) { checkAgainstScalar<std::uint64_t>(); }
+TEST(SimdFindTest, Float) { checkAgainstScalar<float>(); }
+TEST(SimdFindTest, Double) { checkAgainstScalar<double>(); }
+
+TEST(SimdFindTest, EnumsAreSearchable) {
+    static_assert(SimdSearchable<Color>);
+    std::vector<Color> colors(40, Color::Red);
+    colors[33] = Color::Blue;
+    EXPECT_EQ(simdFind(colors.data(), colors.size(), Color::Blue), 33);
+}
+
+TEST(SimdFindTest, FloatEqualitySemantics) {
+    std::vector<float> values(20, 1.0f);
+    values[5] = -0.0f;
+    values[9] = std::numeric_limits<float>::quiet_NaN();
+    EXPECT_EQ(simdFind(values.data(), values.size(), 0.0f), 5);
+    EXPECT_EQ(simdCount(values.data(), values.size(), std::numeric_limits<float>::quiet_NaN()), 0);
+}
+
+#if defined(DS_SIMD_X86)
+TEST(SimdFindTest, KernelsMatchScalar) {
+    std::mt19937 rng{7};
+    auto values = randomValues<std::int32_t>(1000, rng);
+    if (cpuFeatures().sse42) {
+        EXPECT_EQ(Sse42Search::find(values.data(), values.size(), 5), ScalarSearch::find(values.data(), values.size(), 5));
+        EXPECT_EQ(Sse42Search::count(values.data(), values.size(), 5),
+                  ScalarSearch::count(values.data(), values.size(), 5));
+    }
+    if (cpuFeatures().avx2) {
+        auto compacted = values;
+        auto expected = values;
+        compacted.resize(Avx2Search::remove(compacted.data(), 0, compacted.size(), 3));
+        expected.resize(ScalarSearch::remove(expected.data(), 0, expected.size(), 3));
+        EXPECT_EQ(compacted, expected);
+    }
+}
+#endif
@@ -0,0 +1,139 @@
+#include <gtest/gtest.h>
+#include <string>
+#include <vector>
+#include "../src/vector/my_small_vec.hpp"
+
+class MySmallVecTest : public testing::Test {
+protected:
+    SmallVector<int, 4> smallVec;
+    SmallVector<std::string, 2> strVec;
+};
+
+TEST_F(MySmallVecTest, DefaultConstructorIsInline) {
+    EXPECT_EQ(smallVec.size(), 0);
+    EXPECT_EQ(smallVec.capacity(), 4);
+    EXPECT_TRUE(smallVec.isInline());
+    EXPECT_TRUE(smallVec.empty());
+}
+
+TEST_F(MySmallVecTest, StaysInlineUpToN) {
+    for (int i = 0; i < 4; ++i) {
+        smallVec.pushBack(i);
+    }
+    EXPECT_TRUE(smallVec.isInline());
+    EXPECT_EQ(smallVec.capacity(), 4);
+    EXPECT_EQ(smallVec.back(), 3);
+}
+
+TEST_F(MySmallVecTest, SpillsToHeap) {
+    for (int i = 0; i < 10; ++i) {
+        smallVec.pushBack(i);
+    }
+    EXPECT_FALSE(smallVec.isInline());
+    EXPECT_GE(smallVec.capacity(), 10);
+    for (int i = 0; i < 10; ++i) {
+        EXPECT_EQ(smallVec[i], i);
+    }
+}
+
+TEST_F(MySmallVecTest, ConstructorWithSizeAndValue) {
+    SmallVector<int, 4> vec(6, 9);
+    EXPECT_EQ(vec.size(), 6);
+    EXPECT_FALSE(vec.isInline());
+    EXPECT_EQ(vec[5], 9);
+}
+
+TEST_F(MySmallVecTest, CopyConstructor) {
+    strVec.pushBack("one");
+    strVec.pushBack("two");
+    strVec.pushBack("three");
+    SmallVector<std::string, 2> copy(strVec);
+    EXPECT_EQ(copy, strVec);
+    EXPECT_EQ(copy[2], "three");
+}
+
+TEST_F(MySmallVecTest, MoveStealsHeapBuffer) {
+    for (int i = 0; i < 10; ++i) {
+        smallVec.pushBack(i);
+    }
+    const int* heap = smallVec.data();
+    SmallVector<int, 4> moved(std::move(smallVec));
+    EXPECT_EQ(moved.data(), heap);
+    EXPECT_EQ(moved.size(), 10);
+    EXPECT_TRUE(smallVec.empty());
+    EXPECT_TRUE(smallVec.isInline());
+}
+
+TEST_F(MySmallVecTest, MoveInlineRelocatesElements) {
+    strVec.pushBack(std::string(40, 'a'));
+    SmallVector<std::string, 2> moved;
+    moved = std::move(strVec);
+    EXPECT_TRUE(moved.isInline());
+    EXPECT_EQ(moved.size(), 1);
+    EXPECT_EQ(moved[0], std::string(40, 'a'));
+    EXPECT_TRUE(strVec.empty());
+}
+
+TEST_F(MySmallVecTest, ShrinkToFitReturnsInline) {
+    for (int i = 0; i < 10; ++i) {
+        smallVec.pushBack(i);
+    }
+    smallVec.resize(3);
+    smallVec.shrinkToFit();
+    EXPECT_TRUE(smallVec.isInline());
+    EXPECT_EQ(smallVec.size(), 3);
+    EXPECT_EQ(smallVec[2], 2);
+}
+
+TEST_F(MySmallVecTest, ResizeAndReserve) {
+    smallVec.resize(3, 7);
+    EXPECT_EQ(smallVec.size(), 3);
+    smallVec.reserve(32);
+    EXPECT_EQ(smallVec.capacity(), 32);
+    EXPECT_EQ(smallVec[2], 7);
+    smallVec.resize(1);
+    EXPECT_EQ(smallVec.size(), 1);
+}
+
+TEST_F(MySmallVecTest, EmplaceBack) {
+    SmallVector<std::pair<int, std::string>, 1> vec;
+    vec.emplaceBack(1, "a");
+    vec.emplaceBack(2, "b");
+    EXPECT_EQ(vec.size(), 2);
+    EXPECT_EQ(vec[1].second, "b");
+}
+
+TEST_F(MySmallVecTest, EraseByValueAndPosition) {
+    SmallVector<int, 4> vec{1, 2, 3, 2, 4, 2};
+    vec.erase(2);
+    EXPECT_EQ(vec, (SmallVector<int, 4>{1, 3, 4}));
+    auto it = vec.erase(vec.begin());
+    EXPECT_EQ(*it, 3);
+    EXPECT_EQ(vec.size(), 2);
+}
+
+TEST_F(MySmallVecTest, InsertAndAppendRange) {
+    std::vector<int> src{5, 6, 7};
+    smallVec.pushBack(1);
+    smallVec.pushBack(9);
+    smallVec.insert(smallVec.begin() + 1, src.begin(), src.end());
+    EXPECT_EQ(smallVec, (SmallVector<int, 4>{1, 5, 6, 7, 9}));
+    smallVec.appendRange(src);
+    EXPECT_EQ(smallVec.size(), 8);
+    EXPECT_EQ(smallVec.back(), 7);
+}
+
+TEST_F(MySmallVecTest, Swap) {
+    SmallVector<int, 4> a{1, 2};
+    SmallVector<int, 4> b{3, 4, 5, 6, 7};
+    swap(a, b);
+    EXPECT_EQ(a.size(), 5);
+    EXPECT_EQ(b.size(), 2);
+    EXPECT_TRUE(b.isInline());
+}
+
+TEST_F(MySmallVecTest, OutOfRangeAccess) {
+    smallVec.pushBack(1);
+    EXPECT_THROW(smallVec.at(1), std::out_of_range);
+    EXPECT_NO_THROW(smallVec.at(0));
+}
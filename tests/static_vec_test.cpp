@@ -0,0 +1,129 @@
+#include <gtest/gtest.h>
+#include <memory>
+#include <string>
+#include <vector>
+#include "../src/vector/my_static_vec.hpp"
+
+namespace {
+    constexpr int constexprSum() {
+        StaticVector<int, 8> vec{1, 2, 3};
+        vec.pushBack(4);
+        vec.emplaceBack(5);
+        vec.erase(2);
+        int sum = 0;
+        for (int v: vec) {
+            sum += v;
+        }
+        return sum;
+    }
+
+    constexpr bool constexprTryPushBack() {
+        StaticVector<int, 2> vec;
+        return vec.tryPushBack(1) && vec.tryPushBack(2) && !vec.tryPushBack(3) && vec.size() == 2;
+    }
+
+    struct Tracked {
+        static inline int live = 0;
+
+        int value{};
+
+        Tracked(int v) : value{v} { ++live; }
+        Tracked(const Tracked& other) : value{other.value} { ++live; }
+        ~Tracked() { --live; }
+    };
+} // namespace
+
+static_assert(constexprSum() == 13);
+static_assert(constexprTryPushBack());
+static_assert(std::is_same_v<StaticVector<int, 200>::size_type, std::uint8_t>);
+static_assert(std::is_same_v<StaticVector<int, 1000>::size_type, std::uint16_t>);
+static_assert(sizeof(StaticVector<char, 15>) == 16);
+static_assert(std::is_trivially_destructible_v<StaticVector<int, 4>>);
+
+class MyStaticVecTest : public testing::Test {
+protected:
+    StaticVector<int, 4> vec;
+};
+
+TEST_F(MyStaticVecTest, DefaultConstructor) {
+    EXPECT_EQ(vec.size(), 0);
+    EXPECT_EQ(vec.capacity(), 4);
+    EXPECT_TRUE(vec.empty());
+    EXPECT_FALSE(vec.full());
+}
+
+TEST_F(MyStaticVecTest, PushBackUntilFull) {
+    for (int i = 0; i < 4; ++i) {
+        vec.pushBack(i);
+    }
+    EXPECT_TRUE(vec.full());
+    EXPECT_THROW(vec.pushBack(4), std::out_of_range);
+    EXPECT_FALSE(vec.tryPushBack(4));
+    EXPECT_EQ(vec.back(), 3);
+}
+
+TEST_F(MyStaticVecTest, ElementsAreNotConstructedUpFront) {
+    Tracked::live = 0;
+    {
+        StaticVector<Tracked, 16> tracked;
+        EXPECT_EQ(Tracked::live, 0);
+        tracked.emplaceBack(1);
+        tracked.emplaceBack(2);
+        EXPECT_EQ(Tracked::live, 2);
+        tracked.popBack();
+        EXPECT_EQ(Tracked::live, 1);
+    }
+    EXPECT_EQ(Tracked::live, 0);
+}
+
+TEST_F(MyStaticVecTest, CopyAndMove) {
+    StaticVector<std::string, 3> strs{"a", "b", std::string(40, 'c')};
+    StaticVector<std::string, 3> copy(strs);
+    EXPECT_EQ(copy, strs);
+    StaticVector<std::string, 3> moved(std::move(copy));
+    EXPECT_EQ(moved[2], std::string(40, 'c'));
+    copy = moved;
+    EXPECT_EQ(copy.size(), 3);
+}
+
+TEST_F(MyStaticVecTest, MoveOnlyElements) {
+    StaticVector<std::unique_ptr<int>, 2> ptrs;
+    ptrs.emplaceBack(std::make_unique<int>(5));
+    StaticVector<std::unique_ptr<int>, 2> moved(std::move(ptrs));
+    EXPECT_EQ(*moved[0], 5);
+}
+
+TEST_F(MyStaticVecTest, ResizeAndReserve) {
+    vec.resize(3, 9);
+    EXPECT_EQ(vec.size(), 3);
+    EXPECT_EQ(vec[2], 9);
+    EXPECT_THROW(vec.resize(5), std::out_of_range);
+    EXPECT_THROW(vec.reserve(5), std::out_of_range);
+    vec.resize(1);
+    EXPECT_EQ(vec.size(), 1);
+}
+
+TEST_F(MyStaticVecTest, InsertRangeRollsBackWhenFull) {
+    vec.pushBack(1);
+    std::vector<int> src{2, 3, 4, 5};
+    EXPECT_THROW(vec.insert(vec.begin(), src.begin(), src.end()), std::out_of_range);
+    EXPECT_EQ(vec.size(), 1);
+    vec.insert(vec.begin(), src.begin(), src.begin() + 3);
+    EXPECT_EQ(vec, (StaticVector<int, 4>{2, 3, 4, 1}));
+}
+
+TEST_F(MyStaticVecTest, EraseAndAssign) {
+    vec.assign({1, 2, 1, 3});
+    vec.erase(1);
+    EXPECT_EQ(vec, (StaticVector<int, 4>{2, 3}));
+    vec.erase(vec.begin());
+    EXPECT_EQ(vec.front(), 3);
+    vec.assign(2, 8);
+    EXPECT_EQ(vec, (StaticVector<int, 4>{8, 8}));
+}
+
+TEST_F(MyStaticVecTest, OutOfRangeAccess) {
+    vec.pushBack(1);
+    EXPECT_THROW(vec.at(1), std::out_of_range);
+    EXPECT_NO_THROW(vec.at(0));
+}
@@ -0,0 +1,103 @@
+#include <gtest/gtest.h>
+#include <random>
+#include <ranges>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "../src/simd/str_search.hpp"
+#include "../src/string/str_split.hpp"
+
+namespace {
+    std::string randomText(std::size_t n, std::mt19937& rng) {
+        std::uniform_int_distribution<int> dist('a', 'd');
+        std::string text(n, ' ');
+        for (auto& c: text) {
+            c = static_cast<char>(dist(rng));
+        }
+        return text;
+    }
+
+    std::size_t orN(std::size_t pos, std::size_t n) { return pos == std::string_view::npos ? n : pos; }
+
+    std::vector<std::string> splitStd(std::string_view text, std::string_view delim) {
+        std::vector<std::string> pieces;
+        for (auto piece: std::views::split(text, delim)) {
+            pieces.emplace_back(piece.begin(), piece.end());
+        }
+        return pieces;
+    }
+
+    template<typename Delim>
+    std::vector<std::string> splitOurs(std::string_view text, Delim delim) {
+        std::vector<std::string> pieces;
+        for (std::string_view piece: StrSplitView<Delim>{text, delim}) {
+            pieces.emplace_back(piece);
+        }
+        return pieces;
+    }
+} // namespace
+
+// Every haystack length up to 150 covers the vector loops of both widths and their scalar tails.
+TEST(StrSearchTest, FindAndRFindMatchStringView) {
+    std::mt19937 rng{1};
+    for (std::size_t n = 0; n < 150; ++n) {
+        std::string hay = randomText(n, rng);
+        std::string_view view{hay};
+        for (std::size_t m = 1; m <= 5; ++m) {
+            for (int trial = 0; trial < 4; ++trial) {
+                std::string needle = randomText(m, rng);
+                ASSERT_EQ(simdFind(hay.data(), n, needle.data(), m), orN(view.find(needle), n)) << hay << " " << needle;
+                ASSERT_EQ(simdRFind(hay.data(), n, needle.data(), m), orN(view.rfind(needle), n))
+                    << hay << " " << needle;
+            }
+        }
+        for (char c: {'a', 'd', 'z'}) {
+            ASSERT_EQ(simdFind(hay.data(), n, c), orN(view.find(c), n));
+            ASSERT_EQ(simdRFind(hay.data(), n, c), orN(view.rfind(c), n));
+        }
+    }
+}
+
+TEST(StrSearchTest, LongNeedleAtEdges) {
+    std::string hay(300, 'x');
+    std::string needle = "needle-with-a-long-middle-part";
+    hay.replace(0, needle.size(), needle);
+    hay.replace(hay.size() - needle.size(), needle.size(), needle);
+    EXPECT_EQ(simdFind(hay.data(), hay.size(), needle.data(), needle.size()), 0);
+    EXPECT_EQ(simdRFind(hay.data(), hay.size(), needle.data(), needle.size()), hay.size() - needle.size());
+    EXPECT_EQ(simdFind(hay.data(), 10, needle.data(), needle.size()), 10);
+}
+
+#if defined(DS_SIMD_X86)
+TEST(StrSearchTest, Sse42KernelsMatchScalar) {
+    if (!cpuFeatures().sse42) {
+        GTEST_SKIP();
+    }
+    std::mt19937 rng{3};
+    for (std::size_t n = 3; n < 100; ++n) {
+        std::string hay = randomText(n, rng);
+        std::string needle = randomText(3, rng);
+        ASSERT_EQ(Sse42StrSearch::find(hay.data(), n, needle.data(), 3),
+                  ScalarStrSearch::find(hay.data(), n, needle.data(), 3));
+        ASSERT_EQ(Sse42StrSearch::rfind(hay.data(), n, needle.data(), 3),
+                  ScalarStrSearch::rfind(hay.data(), n, needle.data(), 3));
+        ASSERT_EQ(Sse42StrSearch::rfind(hay.data(), n, 'c'), ScalarStrSearch::rfind(hay.data(), n, 'c'));
+    }
+}
+#endif
+
+TEST(StrSearchTest, SplitMatchesStdViewsSplit) {
+    std::mt19937 rng{2};
+    for (std::size_t n = 0; n < 100; ++n) {
+        std::string text = randomText(n, rng);
+        ASSERT_EQ(splitOurs(text, 'a'), splitStd(text, "a")) << text;
+        ASSERT_EQ(splitOurs(text, std::string_view{"ab"}), splitStd(text, "ab")) << text;
+    }
+}
+
+TEST(StrSearchTest, SplitEdgeCases) {
+    EXPECT_TRUE(splitOurs("", ',').empty());
+    EXPECT_EQ(splitOurs(",", ','), (std::vector<std::string>{"", ""}));
+    EXPECT_EQ(splitOurs("a,,b,", ','), (std::vector<std::string>{"a", "", "b", ""}));
+    EXPECT_EQ(splitOurs("k=v", std::string_view{}), (std::vector<std::string>{"k=v"}));
+}
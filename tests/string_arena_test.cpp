@@ -0,0 +1,100 @@
+#include <gtest/gtest.h>
+#include <string>
+#include <unordered_set>
+#include <vector>
+#include "../src/string/string_arena.hpp"
+
+class MyStringArenaTest : public testing::Test {
+protected:
+    StringArena arena{256};
+};
+
+TEST_F(MyStringArenaTest, DefaultArenaStringIsEmpty) {
+    ArenaString str;
+    EXPECT_TRUE(str.empty());
+    EXPECT_EQ(str.size(), 0);
+    EXPECT_STREQ(str.c_str(), "");
+}
+
+TEST_F(MyStringArenaTest, StoreCopiesAndTerminates) {
+    std::string source = "temporary buffer contents";
+    ArenaString str = arena.store(std::string_view{source});
+    source.assign(source.size(), '#');
+    EXPECT_EQ(str, "temporary buffer contents");
+    EXPECT_EQ(str.size(), 25);
+    EXPECT_EQ(str.c_str()[str.size()], '\0');
+    EXPECT_EQ(str[0], 't');
+    EXPECT_EQ(str.at(24), 's');
+    EXPECT_THROW((void)str.at(25), std::out_of_range);
+}
+
+TEST_F(MyStringArenaTest, StringsAreBumpAllocatedInOneChunk) {
+    ArenaString a = arena.store("first");
+    ArenaString b = arena.store("second");
+    EXPECT_EQ(b.data(), a.data() + a.size() + 1);
+    EXPECT_EQ(arena.chunk_count(), 1);
+    EXPECT_EQ(arena.bytes_used(), 13);
+}
+
+TEST_F(MyStringArenaTest, FillsNewChunksAndGivesLargeStringsTheirOwn) {
+    std::vector<ArenaString> strs;
+    for (int i = 0; i < 100; ++i) {
+        strs.push_back(arena.store(std::string_view(std::to_string(i) + "-field-value")));
+    }
+    EXPECT_GT(arena.chunk_count(), 1);
+    for (int i = 0; i < 100; ++i) {
+        EXPECT_EQ(strs[i], std::string_view(std::to_string(i) + "-field-value"));
+    }
+
+    std::size_t chunks = arena.chunk_count();
+    ArenaString tail = arena.store("x");
+    std::string big(1000, 'b');
+    ArenaString large = arena.store(std::string_view{big});
+    ArenaString next = arena.store("y");
+    EXPECT_EQ(large, std::string_view{big});
+    EXPECT_EQ(arena.chunk_count(), chunks + 1);
+    EXPECT_EQ(next.data(), tail.data() + 2);
+}
+
+TEST_F(MyStringArenaTest, ConvertsToString) {
+    std::string text(40, 'q');
+    ArenaString str = arena.store(std::string_view{text});
+    String owned = str.to_string();
+    String explicitOwned{static_cast<String>(str)};
+    arena.release();
+    EXPECT_EQ(owned, String(text.c_str()));
+    EXPECT_EQ(explicitOwned, owned);
+    EXPECT_EQ(owned.hash(), StringHash{}(std::string_view{text}));
+}
+
+TEST_F(MyStringArenaTest, HashAndCompareLikeString) {
+    ArenaString a = arena.store("label_name");
+    ArenaString b = arena.store(String("label_name"));
+    EXPECT_EQ(a, b);
+    EXPECT_NE(a.data(), b.data());
+    EXPECT_EQ(a.hash(), String("label_name").hash());
+    EXPECT_LT(arena.store("abc"), arena.store("abd"));
+
+    std::unordered_set<ArenaString> set{a, b, arena.store("other")};
+    EXPECT_EQ(set.size(), 2);
+}
+
+TEST_F(MyStringArenaTest, ReleaseFreesEverything) {
+    for (int i = 0; i < 50; ++i) {
+        (void)arena.store("some repeated field");
+    }
+    EXPECT_GT(arena.bytes_reserved(), 0);
+    arena.release();
+    EXPECT_EQ(arena.chunk_count(), 0);
+    EXPECT_EQ(arena.bytes_used(), 0);
+    EXPECT_EQ(arena.store("again"), "again");
+}
+
+TEST_F(MyStringArenaTest, MoveTransfersOwnership) {
+    ArenaString str = arena.store("kept alive by the moved-to arena");
+    StringArena other{std::move(arena)};
+    EXPECT_EQ(arena.chunk_count(), 0);
+    EXPECT_EQ(other.chunk_count(), 1);
+    EXPECT_EQ(str, "kept alive by the moved-to arena");
+    EXPECT_THROW(StringArena{0}, std::invalid_argument);
+}
@@ -0,0 +1,96 @@
+#include <gtest/gtest.h>
+#include <string>
+#include <thread>
+#include <unordered_set>
+#include <vector>
+#include "../src/string/string_interner.hpp"
+
+class MyStringInternerTest : public testing::Test {
+protected:
+    StringInterner interner;
+};
+
+TEST_F(MyStringInternerTest, SameTextSameAtom) {
+    Atom a = interner.intern("service");
+    Atom b = interner.intern(std::string_view{"service"});
+    Atom c = interner.intern(String{"service"});
+    EXPECT_EQ(a, b);
+    EXPECT_EQ(a, c);
+    EXPECT_EQ(a.id(), b.id());
+    EXPECT_EQ(&a.str(), &b.str());
+    EXPECT_EQ(a.view(), "service");
+    EXPECT_EQ(interner.size(), 1);
+}
+
+TEST_F(MyStringInternerTest, DifferentTextDifferentAtom) {
+    Atom a = interner.intern("method");
+    Atom b = interner.intern("status_code_with_a_long_label_name");
+    EXPECT_NE(a, b);
+    EXPECT_NE(a.id(), b.id());
+    EXPECT_EQ(b.str(), String{"status_code_with_a_long_label_name"});
+    EXPECT_EQ(std::hash<Atom>{}(a), a.hash());
+    EXPECT_EQ(interner.size(), 2);
+}
+
+TEST_F(MyStringInternerTest, DefaultAtomIsNull) {
+    Atom none;
+    EXPECT_FALSE(none);
+    EXPECT_EQ(none.view(), "");
+    Atom empty = interner.intern("");
+    EXPECT_TRUE(empty);
+    EXPECT_NE(none, empty);
+    EXPECT_EQ(empty.view(), "");
+}
+
+TEST_F(MyStringInternerTest, FindDoesNotInsert) {
+    EXPECT_FALSE(interner.find("missing"));
+    Atom a = interner.intern("present");
+    auto found = interner.find("present");
+    ASSERT_TRUE(found);
+    EXPECT_EQ(*found, a);
+    EXPECT_EQ(interner.size(), 1);
+}
+
+TEST_F(MyStringInternerTest, AtomsStayValidAsPoolGrows) {
+    std::vector<Atom> atoms;
+    for (int i = 0; i < 10'000; ++i) {
+        atoms.push_back(interner.intern(std::to_string(i) + "-label"));
+    }
+    for (int i = 0; i < 10'000; ++i) {
+        ASSERT_EQ(atoms[i].view(), std::to_string(i) + "-label");
+        ASSERT_EQ(interner.intern(std::to_string(i) + "-label"), atoms[i]);
+    }
+}
+
+TEST_F(MyStringInternerTest, ConcurrentInterningAgreesOnIds) {
+    constexpr int threads = 8;
+    constexpr int labels = 2000;
+    std::vector<std::vector<Atom>> seen(threads);
+    std::vector<std::thread> workers;
+    for (int t = 0; t < threads; ++t) {
+        workers.emplace_back([&, t] {
+            for (int i = 0; i < labels; ++i) {
+                int label = (i * 7 + t * 13) % labels;
+                seen[t].push_back(interner.intern("label-" + std::to_string(label)));
+            }
+        });
+    }
+    for (auto& worker: workers) {
+        worker.join();
+    }
+
+    EXPECT_EQ(interner.size(), labels);
+    std::unordered_set<std::uint32_t> ids;
+    for (int i = 0; i < labels; ++i) {
+        Atom atom = *interner.find("label-" + std::to_string(i));
+        ids.insert(atom.id());
+        for (int t = 0; t < threads; ++t) {
+            int pos = 0;
+            while ((pos * 7 + t * 13) % labels != i) {
+                ++pos;
+            }
+            ASSERT_EQ(seen[t][pos], atom);
+        }
+    }
+    EXPECT_EQ(ids.size(), labels);
+}
@@ -1,6 +1,9 @@
 #include <gtest/gtest.h>
 #include <sstream>
+#include <stdexcept>
 #include <string>
+#include <unordered_set>
+#include <vector>
 #include "../src/string/my_string.hpp"
 
 class MyStringTest : public testing::Test {
@@ -160,3 +163,271 @@ TEST_F(MyStringTest, LargeStringBeyondSSO) {
     EXPECT_EQ(str.size(), 40);
     EXPECT_EQ(std::string_view(str.data(), str.size()), beyondSSO);
 }
+
+TEST_F(MyStringTest, AppendStaysInlineWithinSSO) {
+    String str("Hello");
+    str.append(", ").append("World");
+    str += '!';
+    EXPECT_EQ(std::string_view(str.data(), str.size()), "Hello, World!");
+    EXPECT_EQ(str.capacity(), String::SSO_LEN);
+}
+
+TEST_F(MyStringTest, AppendGrowsGeometrically) {
+    String str;
+    std::string expected;
+    std::size_t reallocations = 0;
+    std::size_t lastCap = str.capacity();
+    for (int i = 0; i < 10'000; ++i) {
+        str += static_cast<char>('a' + i % 26);
+        expected += static_cast<char>('a' + i % 26);
+        if (str.capacity() != lastCap) {
+            ++reallocations;
+            lastCap = str.capacity();
+        }
+    }
+    EXPECT_EQ(std::string_view(str.data(), str.size()), expected);
+    EXPECT_EQ(str.c_str()[str.size()], '\0');
+    EXPECT_LE(reallocations, 10);
+}
+
+TEST_F(MyStringTest, AppendSelf) {
+    String str(largeStr);
+    str += str;
+    EXPECT_EQ(str.size(), 200);
+    EXPECT_EQ(std::string_view(str.data(), str.size()), std::string(200, 'A'));
+
+    String small("ab");
+    small.append(small);
+    EXPECT_EQ(std::string_view(small.data(), small.size()), "abab");
+}
+
+TEST_F(MyStringTest, ReserveKeepsContents) {
+    String str("abc");
+    str.reserve(500);
+    EXPECT_GE(str.capacity(), 500);
+    EXPECT_EQ(std::string_view(str.data(), str.size()), "abc");
+
+    const char* buf = str.data();
+    for (int i = 0; i < 400; ++i) {
+        str.push_back('x');
+    }
+    EXPECT_EQ(str.data(), buf);
+    EXPECT_EQ(str.size(), 403);
+}
+
+TEST_F(MyStringTest, ShortHeapStringCopiesAndMoves) {
+    String str;
+    str.reserve(100);
+    str += "short";
+    String copy = str;
+    EXPECT_EQ(copy, str);
+    EXPECT_EQ(copy.capacity(), String::SSO_LEN);
+
+    String moved = std::move(str);
+    EXPECT_EQ(std::string_view(moved.data(), moved.size()), "short");
+    EXPECT_GE(moved.capacity(), 100);
+    EXPECT_EQ(str.size(), 0);
+
+    copy = moved;
+    EXPECT_EQ(copy, moved);
+}
+
+TEST_F(MyStringTest, CopyAssignmentReusesCapacity) {
+    String str(std::string(200, 'x'));
+    const char* buf = str.data();
+    str = largeStr;
+    EXPECT_EQ(str.data(), buf);
+    EXPECT_EQ(str, largeStr);
+}
+
+TEST_F(MyStringTest, ResizeAndOverwrite) {
+    String str("id=");
+    str.resize_and_overwrite(64, [](char* buf, std::size_t) {
+        std::memcpy(buf + 3, "12345", 5);
+        return std::size_t{8};
+    });
+    EXPECT_EQ(std::string_view(str.data(), str.size()), "id=12345");
+    EXPECT_GE(str.capacity(), 64);
+
+    EXPECT_THROW(str.resize_and_overwrite(4, [](char*, std::size_t n) { return n + 1; }), std::length_error);
+}
+
+TEST_F(MyStringTest, CompactLayout) {
+    EXPECT_EQ(sizeof(String), 24);
+    EXPECT_EQ(String::SSO_LEN, 23);
+    EXPECT_EQ(defaultStr.capacity(), 23);
+    EXPECT_EQ(defaultStr.c_str()[0], '\0');
+}
+
+TEST_F(MyStringTest, InlineBoundary) {
+    std::string full(23, 'z');
+    String inlineStr(full);
+    EXPECT_EQ(inlineStr.size(), 23);
+    EXPECT_EQ(inlineStr.capacity(), 23);
+    EXPECT_EQ(inlineStr.c_str()[23], '\0');
+    EXPECT_EQ(std::string_view(inlineStr.data(), inlineStr.size()), full);
+    // An inline string lives inside the object itself.
+    EXPECT_EQ(static_cast<const void*>(inlineStr.data()), static_cast<const void*>(&inlineStr));
+
+    inlineStr += 'z';
+    EXPECT_EQ(inlineStr.size(), 24);
+    EXPECT_GT(inlineStr.capacity(), 23);
+    EXPECT_NE(static_cast<const void*>(inlineStr.data()), static_cast<const void*>(&inlineStr));
+    EXPECT_EQ(std::string_view(inlineStr.data(), inlineStr.size()), full + 'z');
+}
+
+TEST_F(MyStringTest, InlineSizesRoundTrip) {
+    String str;
+    for (std::size_t i = 0; i <= 23; ++i) {
+        EXPECT_EQ(str.size(), i);
+        EXPECT_EQ(str.capacity(), 23);
+        EXPECT_EQ(std::strlen(str.c_str()), i);
+        str.push_back('a');
+    }
+}
+
+TEST_F(MyStringTest, HugeCapacityRoundTrips) {
+    String str;
+    str.reserve(std::size_t{1} << 20);
+    EXPECT_EQ(str.capacity(), std::size_t{1} << 20);
+    EXPECT_EQ(str.size(), 0);
+}
+
+TEST_F(MyStringTest, FindAndRFind) {
+    String str("GET /index.html HTTP/1.1 GET /a HTTP/1.1");
+    std::string_view view(str.data(), str.size());
+    EXPECT_EQ(str.find('/'), view.find('/'));
+    EXPECT_EQ(str.find('/', 5), view.find('/', 5));
+    EXPECT_EQ(str.find('#'), String::npos);
+    EXPECT_EQ(str.find("HTTP"), view.find("HTTP"));
+    EXPECT_EQ(str.find("HTTP", 20), view.find("HTTP", 20));
+    EXPECT_EQ(str.find("HTTP/2"), String::npos);
+    EXPECT_EQ(str.find(""), 0);
+    EXPECT_EQ(str.find("", str.size()), str.size());
+    EXPECT_EQ(str.find("x", str.size() + 1), String::npos);
+
+    EXPECT_EQ(str.rfind('/'), view.rfind('/'));
+    EXPECT_EQ(str.rfind('/', 10), view.rfind('/', 10));
+    EXPECT_EQ(str.rfind("GET"), view.rfind("GET"));
+    EXPECT_EQ(str.rfind("GET", 24), view.rfind("GET", 24));
+    EXPECT_EQ(str.rfind(""), view.rfind(""));
+    EXPECT_EQ(String("ab").rfind("abc"), String::npos);
+    EXPECT_EQ(defaultStr.rfind('a'), String::npos);
+}
+
+TEST_F(MyStringTest, ContainsAndCount) {
+    String line("level=warn msg=\"disk warn\" warnings=3");
+    EXPECT_TRUE(line.contains('='));
+    EXPECT_TRUE(line.contains("disk"));
+    EXPECT_FALSE(line.contains("error"));
+    EXPECT_EQ(line.count('='), 3);
+    EXPECT_EQ(line.count("warn"), 3);
+    EXPECT_EQ(String("aaaa").count("aa"), 2);
+    EXPECT_EQ(line.count(""), 0);
+}
+
+TEST_F(MyStringTest, SplitIsLazyAndViewsIntoString) {
+    String csv("id,name,,email,");
+    std::vector<std::string_view> fields;
+    for (std::string_view field: csv.split(',')) {
+        fields.push_back(field);
+    }
+    ASSERT_EQ(fields.size(), 5);
+    EXPECT_EQ(fields[0], "id");
+    EXPECT_EQ(fields[2], "");
+    EXPECT_EQ(fields[4], "");
+    EXPECT_GE(fields[1].data(), csv.data());
+    EXPECT_LT(fields[1].data(), csv.data() + csv.size());
+
+    String kv("a::b::c");
+    std::size_t pieces = 0;
+    for (std::string_view piece: kv.split("::")) {
+        EXPECT_EQ(piece.size(), 1);
+        ++pieces;
+    }
+    EXPECT_EQ(pieces, 3);
+}
+
+TEST_F(MyStringTest, HashMatchesAcrossViewsAndLayouts) {
+    String shortStr("key");
+    String longStr(std::string(100, 'k').c_str());
+    EXPECT_EQ(shortStr.hash(), StringHash{}(std::string_view{"key"}));
+    EXPECT_EQ(shortStr.hash(), StringHash{}("key"));
+    EXPECT_EQ(std::hash<String>{}(longStr), StringHash{}(std::string_view(std::string(100, 'k'))));
+    EXPECT_EQ(String(longStr).hash(), longStr.hash());
+    EXPECT_NE(String("key1").hash(), String("key2").hash());
+}
+
+TEST_F(MyStringTest, HashFollowsModification) {
+    String str(std::string(40, 'x').c_str());
+    std::size_t before = str.hash();
+    EXPECT_EQ(str.hash(), before);
+    str += 'y';
+    EXPECT_EQ(str.hash(), StringHash{}(std::string_view(std::string(40, 'x') + "y")));
+    str.resize_and_overwrite(3, [](char* buf, std::size_t) {
+        buf[0] = 'a';
+        buf[1] = 'b';
+        buf[2] = 'c';
+        return 3;
+    });
+    EXPECT_EQ(str.hash(), String("abc").hash());
+}
+
+TEST_F(MyStringTest, HashFollowsFailedOverwrite) {
+    String str(std::string(40, 'x').c_str());
+    std::size_t before = str.hash();
+    EXPECT_THROW(str.resize_and_overwrite(40,
+                                          [](char* buf, std::size_t) -> std::size_t {
+                                              buf[0] = 'a';
+                                              throw std::runtime_error{"failed"};
+                                          }),
+                 std::runtime_error);
+    EXPECT_EQ(str.hash(), StringHash{}(std::string_view{str.data(), str.size()}));
+    EXPECT_NE(str.hash(), before);
+
+    before = str.hash();
+    EXPECT_THROW(str.resize_and_overwrite(40,
+                                          [](char* buf, std::size_t n) {
+                                              buf[1] = 'b';
+                                              return n + 1;
+                                          }),
+                 std::length_error);
+    EXPECT_EQ(str.hash(), StringHash{}(std::string_view{str.data(), str.size()}));
+    EXPECT_NE(str.hash(), before);
+}
+
+TEST_F(MyStringTest, HashedStringCarriesTheStringHash) {
+    HashedString empty;
+    HashedString shortKey("key");
+    HashedString longKey(String{std::string(100, 'k').c_str()});
+    EXPECT_EQ(empty.hash(), String{}.hash());
+    EXPECT_EQ(shortKey.hash(), String("key").hash());
+    EXPECT_EQ(longKey.hash(), StringHash{}(std::string_view(std::string(100, 'k'))));
+    EXPECT_EQ(StringHash{}(longKey), longKey.hash());
+    EXPECT_EQ(std::hash<HashedString>{}(shortKey), shortKey.hash());
+    EXPECT_EQ(longKey.size(), 100);
+    EXPECT_EQ(shortKey, HashedString{std::string_view{"key"}});
+    EXPECT_NE(shortKey, HashedString{"kez"});
+    EXPECT_EQ(shortKey, "key");
+    EXPECT_LT(shortKey, longKey);
+}
+
+TEST_F(MyStringTest, HashedStringSetFindsByStringView) {
+    std::unordered_set<HashedString, StringHash, std::equal_to<>> set;
+    set.insert(HashedString{"alpha"});
+    set.insert(HashedString{std::string(64, 'b').c_str()});
+    EXPECT_NE(set.find(std::string_view{"alpha"}), set.end());
+    EXPECT_NE(set.find(std::string_view(std::string(64, 'b'))), set.end());
+    EXPECT_EQ(set.find(std::string_view{"beta"}), set.end());
+}
+
+TEST_F(MyStringTest, UnorderedSetFindsByStringView) {
+    std::unordered_set<String, StringHash, std::equal_to<>> set;
+    set.insert(String("alpha"));
+    set.insert(String(std::string(64, 'b').c_str()));
+    EXPECT_NE(set.find(std::string_view{"alpha"}), set.end());
+    EXPECT_NE(set.find(std::string_view(std::string(64, 'b'))), set.end());
+    EXPECT_EQ(set.find(std::string_view{"beta"}), set.end());
+    EXPECT_TRUE(String("alpha") == "alpha");
+    EXPECT_FALSE(String("alpha") == std::string_view{"alph"});
+}
@@ -0,0 +1,143 @@
+#include <gtest/gtest.h>
+#include <random>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+#include "../src/simd/utf8.hpp"
+#include "../src/string/my_string.hpp"
+
+namespace {
+    // Every kernel the running CPU supports, so the vector paths are checked against the scalar one.
+    std::vector<bool (*)(const char*, std::size_t)> validators() {
+        std::vector<bool (*)(const char*, std::size_t)> kernels{&ScalarUtf8::validate};
+#if defined(DS_SIMD_X86)
+        if (cpuFeatures().sse42) {
+            kernels.push_back(&Sse42Utf8::validate);
+        }
+        if (cpuFeatures().avx2) {
+            kernels.push_back(&Avx2Utf8::validate);
+        }
+#endif
+        return kernels;
+    }
+
+    bool allAgree(std::string_view text, bool expected) {
+        for (auto validate: validators()) {
+            if (validate(text.data(), text.size()) != expected) {
+                return false;
+            }
+        }
+        return simdValidateUtf8(text.data(), text.size()) == expected;
+    }
+
+    std::string encode(char32_t cp) {
+        std::string out;
+        if (cp < 0x80) {
+            out += static_cast<char>(cp);
+        } else if (cp < 0x800) {
+            out += static_cast<char>(0xC0 | (cp >> 6));
+            out += static_cast<char>(0x80 | (cp & 0x3F));
+        } else if (cp < 0x10000) {
+            out += static_cast<char>(0xE0 | (cp >> 12));
+            out += static_cast<char>(0x80 | ((cp >> 6) & 0x3F));
+            out += static_cast<char>(0x80 | (cp & 0x3F));
+        } else {
+            out += static_cast<char>(0xF0 | (cp >> 18));
+            out += static_cast<char>(0x80 | ((cp >> 12) & 0x3F));
+            out += static_cast<char>(0x80 | ((cp >> 6) & 0x3F));
+            out += static_cast<char>(0x80 | (cp & 0x3F));
+        }
+        return out;
+    }
+} // namespace
+
+TEST(Utf8Test, AcceptsWellFormedText) {
+    for (std::string_view text: {"", "plain ascii", "caf\xC3\xA9", "\xE2\x82\xAC 100", "\xF0\x9F\x98\x80",
+                                 "\xED\x9F\xBF", "\xEE\x80\x80", "\xF4\x8F\xBF\xBF", "\xC2\x80"}) {
+        EXPECT_TRUE(allAgree(text, true)) << text;
+    }
+}
+
+TEST(Utf8Test, RejectsMalformedText) {
+    for (std::string_view text: {"\x80", "\xBF", "\xC0\x80", "\xC1\xBF", "\xC3", "\xE2\x82", "\xE0\x80\x80",
+                                 "\xE0\x9F\xBF", "\xED\xA0\x80", "\xF0\x80\x80\x80", "\xF0\x8F\xBF\xBF",
+                                 "\xF4\x90\x80\x80", "\xF5\x80\x80\x80", "\xFF", "\xC3\xA9\xA9", "a\xE2\x82z"}) {
+        EXPECT_TRUE(allAgree(text, false)) << testing::PrintToString(text);
+    }
+}
+
+// Errors at every offset, including across the 16 and 32 byte block boundaries and inside the
+// zero-padded tail, must be caught by every kernel.
+TEST(Utf8Test, VectorKernelsMatchScalarAtEveryOffset) {
+    std::mt19937 rng{7};
+    std::vector<char32_t> samples{'a', 0xE9, 0x20AC, 0x1F600, 0x7FF, 0xFFFF, 0x10000};
+    for (int round = 0; round < 200; ++round) {
+        std::string text;
+        while (text.size() < 100) {
+            text += encode(samples[rng() % samples.size()]);
+        }
+        ASSERT_TRUE(allAgree(text, true));
+        std::size_t n = 1 + rng() % text.size();
+        std::string prefix = text.substr(0, n);
+        bool expected = ScalarUtf8::validate(prefix.data(), prefix.size());
+        ASSERT_TRUE(allAgree(prefix, expected)) << n;
+
+        std::string corrupt = text;
+        corrupt[rng() % corrupt.size()] = static_cast<char>(0x80 | (rng() & 0x7F));
+        expected = ScalarUtf8::validate(corrupt.data(), corrupt.size());
+        ASSERT_TRUE(allAgree(corrupt, expected));
+    }
+}
+
+TEST(Utf8Test, CountsAndIteratesCodePoints) {
+    String text("h\xC3\xA9llo \xE2\x82\xAC\xF0\x9F\x98\x80 and a longer ascii tail for the vector path");
+    std::vector<char32_t> cps;
+    for (char32_t cp: text.code_points()) {
+        cps.push_back(cp);
+    }
+    EXPECT_EQ(text.utf8_length(), cps.size());
+    EXPECT_EQ(ScalarUtf8::count(text.data(), text.size()), cps.size());
+    ASSERT_GE(cps.size(), 9);
+    EXPECT_EQ(cps[1], U'é');
+    EXPECT_EQ(cps[6], U'€');
+    EXPECT_EQ(cps[7], U'\U0001F600');
+}
+
+TEST(Utf8Test, IterationReplacesMalformedBytes) {
+    String bad("a\xFF\xE2\x82z");
+    std::vector<char32_t> cps;
+    for (char32_t cp: bad.code_points()) {
+        cps.push_back(cp);
+    }
+    EXPECT_FALSE(bad.is_valid_utf8());
+    EXPECT_EQ(cps, (std::vector<char32_t>{'a', Utf8View::REPLACEMENT, Utf8View::REPLACEMENT, Utf8View::REPLACEMENT, 'z'}));
+}
+
+TEST(Utf8Test, IgnoreCaseCompareAndHash) {
+    String header("Content-Type");
+    EXPECT_TRUE(header.equals_ignore_case("content-type"));
+    EXPECT_TRUE(header.equals_ignore_case("CONTENT-TYPE"));
+    EXPECT_FALSE(header.equals_ignore_case("content-typo"));
+    EXPECT_FALSE(header.equals_ignore_case("content-type "));
+    EXPECT_EQ(header.hash_ignore_case(), String("CONTENT-TYPE").hash_ignore_case());
+    // '@' and '[' sit next to 'A' and 'Z' and must not fold; non-ASCII bytes compare exactly.
+    EXPECT_FALSE(String("@[").equals_ignore_case("`{"));
+    EXPECT_FALSE(String("\xC3\x89").equals_ignore_case("\xC3\xA9"));
+
+    std::string longA(300, 'X');
+    std::string longB(300, 'x');
+    longA += "-Suffix";
+    longB += "-sUFFIX";
+    EXPECT_TRUE(String(longA.c_str()).equals_ignore_case(longB));
+    EXPECT_EQ(StringHashIgnoreCase{}(std::string_view{longA}), StringHashIgnoreCase{}(std::string_view{longB}));
+
+    std::unordered_map<String, int, StringHashIgnoreCase, StringEqualIgnoreCase> headers;
+    headers.emplace("Accept-Encoding", 1);
+    headers.emplace("X-Request-Id", 2);
+    auto it = headers.find(std::string_view{"accept-encoding"});
+    ASSERT_NE(it, headers.end());
+    EXPECT_EQ(it->second, 1);
+    EXPECT_NE(headers.find(std::string_view{"x-request-ID"}), headers.end());
+    EXPECT_EQ(headers.find(std::string_view{"x-request"}), headers.end());
+}
@@ -0,0 +1,168 @@
+#include <algorithm>
+#include <cstdint>
+#include <gtest/gtest.h>
+#include <limits>
+#include <memory>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+#include "../src/vector/my_vec.hpp"
+#include "../src/vector/vec_sort.hpp"
+
+namespace {
+    template<typename T>
+    Vector<T> randomVector(std::size_t n, std::uint64_t seed) {
+        std::mt19937_64 rng{seed};
+        Vector<T> vec;
+        vec.reserve(n);
+        for (std::size_t i = 0; i < n; ++i) {
+            if constexpr (std::is_floating_point_v<T>) {
+                vec.pushBack(static_cast<T>(std::uniform_real_distribution<double>(-1e6, 1e6)(rng)));
+            } else {
+                vec.pushBack(static_cast<T>(rng()));
+            }
+        }
+        return vec;
+    }
+
+    template<typename Vec>
+    std::vector<typename std::remove_cvref_t<decltype(*std::declval<Vec>().begin())>> sortedCopy(const Vec& vec) {
+        std::vector<std::remove_cvref_t<decltype(*vec.begin())>> copy(vec.begin(), vec.end());
+        std::sort(copy.begin(), copy.end());
+        return copy;
+    }
+
+    template<typename Vec>
+    std::vector<std::remove_cvref_t<decltype(*std::declval<Vec>().begin())>> asStd(const Vec& vec) {
+        return {vec.begin(), vec.end()};
+    }
+} // namespace
+
+TEST(VecSortTest, RadixKeyPreservesOrder) {
+    EXPECT_LT(radixKey(-5), radixKey(3));
+    EXPECT_LT(radixKey(std::numeric_limits<std::int64_t>::min()), radixKey(std::int64_t{-1}));
+    EXPECT_LT(radixKey(-2.5), radixKey(-1.0));
+    EXPECT_LT(radixKey(-0.5f), radixKey(0.25f));
+    EXPECT_LT(radixKey(1.0), radixKey(std::numeric_limits<double>::infinity()));
+}
+
+TEST(VecSortTest, RadixSortUnsigned) {
+    for (std::size_t n: {0, 1, 5, 64, 65, 1000, 100000}) {
+        auto vec = randomVector<std::uint64_t>(n, n);
+        auto expected = sortedCopy(vec);
+        radixSort(vec);
+        EXPECT_EQ(asStd(vec), expected);
+    }
+}
+
+TEST(VecSortTest, RadixSortSignedAndFloat) {
+    auto ints = randomVector<std::int32_t>(50000, 1);
+    auto intsExpected = sortedCopy(ints);
+    radixSort(ints);
+    EXPECT_EQ(asStd(ints), intsExpected);
+
+    auto doubles = randomVector<double>(50000, 2);
+    auto doublesExpected = sortedCopy(doubles);
+    radixSort(doubles);
+    EXPECT_EQ(asStd(doubles), doublesExpected);
+}
+
+TEST(VecSortTest, RadixSortIsStableWithProjection) {
+    Vector<std::pair<std::uint8_t, std::uint32_t>> pairs;
+    std::mt19937 rng{3};
+    for (std::uint32_t i = 0; i < 10000; ++i) {
+        pairs.pushBack({static_cast<std::uint8_t>(rng() % 16), i});
+    }
+    radixSort(pairs, &std::pair<std::uint8_t, std::uint32_t>::first);
+    for (std::size_t i = 1; i < pairs.size(); ++i) {
+        ASSERT_LE(pairs[i - 1].first, pairs[i].first);
+        if (pairs[i - 1].first == pairs[i].first) {
+            ASSERT_LT(pairs[i - 1].second, pairs[i].second);
+        }
+    }
+}
+
+TEST(VecSortTest, ParallelRadixSort) {
+    for (unsigned threads: {1u, 3u, 8u}) {
+        auto vec = randomVector<std::uint64_t>(200000, threads);
+        for (std::size_t i = 0; i < vec.size(); ++i) {
+            vec[i] %= 1'000'000;
+        }
+        auto expected = sortedCopy(vec);
+        parallelRadixSort(vec, std::identity{}, threads);
+        EXPECT_EQ(asStd(vec), expected);
+    }
+}
+
+TEST(VecSortTest, ParallelRadixSortPairsByKey) {
+    Vector<std::pair<std::uint64_t, std::uint64_t>> pairs;
+    std::mt19937_64 rng{4};
+    for (std::uint64_t i = 0; i < 100000; ++i) {
+        pairs.pushBack({rng(), i});
+    }
+    parallelRadixSort(pairs, &std::pair<std::uint64_t, std::uint64_t>::first, 4);
+    EXPECT_TRUE(std::is_sorted(pairs.begin(), pairs.end()));
+}
+
+TEST(VecSortTest, ParallelSampleSortWithComparator) {
+    Vector<std::string> strs;
+    std::mt19937 rng{5};
+    for (int i = 0; i < 60000; ++i) {
+        strs.pushBack(std::to_string(rng() % 5000));
+    }
+    std::vector<std::string> expected(strs.begin(), strs.end());
+    std::sort(expected.begin(), expected.end(), std::greater<>{});
+    parallelSort(strs, std::greater<>{}, std::identity{}, 4);
+    EXPECT_EQ(asStd(strs), expected);
+}
+
+TEST(VecSortTest, AdaptiveSort) {
+    auto small = randomVector<std::int64_t>(100, 6);
+    auto large = randomVector<float>(300000, 7);
+    auto smallExpected = sortedCopy(small);
+    auto largeExpected = sortedCopy(large);
+    adaptiveSort(small);
+    adaptiveSort(large);
+    EXPECT_EQ(asStd(small), smallExpected);
+    EXPECT_EQ(asStd(large), largeExpected);
+
+    std::vector<int> descending{3, 1, 2};
+    adaptiveSort(descending, std::greater<>{});
+    EXPECT_EQ(descending, (std::vector<int>{3, 2, 1}));
+}
+
+TEST(VecSortTest, MoveOnlyElementsSortByProjectedKey) {
+    auto deref = [](const std::unique_ptr<int>& p) { return *p; };
+    auto makeVector = [] {
+        Vector<std::unique_ptr<int>> ptrs;
+        std::mt19937 rng{8};
+        for (int i = 0; i < 20000; ++i) {
+            ptrs.emplaceBack(std::make_unique<int>(static_cast<int>(rng() % 100000)));
+        }
+        return ptrs;
+    };
+    auto values = [](const Vector<std::unique_ptr<int>>& ptrs) {
+        std::vector<int> out;
+        for (const auto& p: ptrs) {
+            out.push_back(*p);
+        }
+        return out;
+    };
+    auto ptrs = makeVector();
+    std::vector<int> expected = values(ptrs);
+    std::sort(expected.begin(), expected.end(), std::greater<>{});
+
+    parallelSort(ptrs, std::ranges::greater{}, deref, 4);
+    EXPECT_EQ(values(ptrs), expected);
+
+    auto adaptive = makeVector();
+    adaptiveSort(adaptive, std::ranges::greater{}, deref);
+    EXPECT_EQ(values(adaptive), expected);
+
+    // The key is the unique_ptr itself, which cannot be sampled; adaptiveSort falls back to
+    // std::ranges::sort.
+    auto byPointee = makeVector();
+    adaptiveSort(byPointee, [](const auto& a, const auto& b) { return *a > *b; });
+    EXPECT_EQ(values(byPointee), expected);
+}
@@ -1,7 +1,33 @@
+#include <cstdint>
+#include <cstring>
 #include <gtest/gtest.h>
+#include <iterator>
+#include <list>
+#include <numeric>
+#include <ranges>
+#include <sstream>
+#include <string>
+#include <string_view>
 #include <vector>
+#include "../src/vector/mmap_allocator.hpp"
 #include "../src/vector/my_vec.hpp"
 
+namespace {
+    struct RelocCounted {
+        static inline int moves = 0;
+
+        int value{};
+
+        RelocCounted(int v) : value{v} {}
+        RelocCounted(const RelocCounted& other) : value{other.value} {}
+        RelocCounted(RelocCounted&& other) noexcept : value{other.value} { ++moves; }
+        ~RelocCounted() {}
+    };
+} // namespace
+
+template<>
+struct TriviallyRelocatable<RelocCounted> : std::true_type {};
+
 class MyVecTest : public testing::Test {
 protected:
     Vector<int> defaultVec;
@@ -136,3 +162,245 @@ TEST_F(MyVecTest, Clear) {
     EXPECT_EQ(vec.size(), 0);
     EXPECT_TRUE(vec.empty());
 }
+
+TEST_F(MyVecTest, GrowthKeepsTriviallyCopyableElements) {
+    Vector<std::uint64_t> vec;
+    for (std::uint64_t i = 0; i < 1000; ++i) {
+        vec.pushBack(i * 3);
+    }
+    EXPECT_EQ(vec.size(), 1000);
+    for (std::uint64_t i = 0; i < 1000; ++i) {
+        EXPECT_EQ(vec[i], i * 3);
+    }
+}
+
+TEST_F(MyVecTest, GrowthMovesNonTrivialElements) {
+    Vector<std::string> vec;
+    for (int i = 0; i < 100; ++i) {
+        vec.pushBack(std::string(40, static_cast<char>('a' + i % 26)));
+    }
+    EXPECT_EQ(vec.size(), 100);
+    EXPECT_EQ(vec[99], std::string(40, static_cast<char>('a' + 99 % 26)));
+}
+
+TEST_F(MyVecTest, RelocatableTraitSkipsMoveConstructor) {
+    RelocCounted::moves = 0;
+    Vector<RelocCounted> vec;
+    for (int i = 0; i < 64; ++i) {
+        vec.emplaceBack(i);
+    }
+    vec.shrinkToFit();
+    EXPECT_EQ(RelocCounted::moves, 0);
+    for (int i = 0; i < 64; ++i) {
+        EXPECT_EQ(vec[i].value, i);
+    }
+}
+
+TEST_F(MyVecTest, MmapAllocatorGrowthAndShrink) {
+    Vector<std::uint64_t, MmapAllocator<std::uint64_t, 4096>> vec;
+    for (std::uint64_t i = 0; i < 100000; ++i) {
+        vec.pushBack(i);
+    }
+    vec.resize(100);
+    vec.shrinkToFit();
+    EXPECT_EQ(vec.capacity(), 100);
+    for (std::uint64_t i = 0; i < 100; ++i) {
+        EXPECT_EQ(vec[i], i);
+    }
+    vec.reserve(50000);
+    EXPECT_EQ(vec[99], 99);
+}
+
+TEST_F(MyVecTest, AssignInitializerList) {
+    Vector<int> vec(10, 1);
+    vec.assign({5, 6, 7});
+    EXPECT_EQ(vec.size(), 3);
+    EXPECT_EQ(vec[0], 5);
+    EXPECT_EQ(vec[2], 7);
+}
+
+TEST_F(MyVecTest, AssignIteratorRange) {
+    std::list<std::string> src{"a", "b", "c", "d"};
+    Vector<std::string> vec(2, "x");
+    vec.assign(src.begin(), src.end());
+    EXPECT_EQ(vec.size(), 4);
+    EXPECT_EQ(vec[0], "a");
+    EXPECT_EQ(vec[3], "d");
+}
+
+TEST_F(MyVecTest, AppendRangeReservesOnce) {
+    std::vector<int> src(1000);
+    std::iota(src.begin(), src.end(), 0);
+    Vector<int> vec{-1};
+    vec.appendRange(src);
+    EXPECT_EQ(vec.size(), 1001);
+    EXPECT_EQ(vec.capacity(), 1001);
+    EXPECT_EQ(vec[0], -1);
+    EXPECT_EQ(vec[1000], 999);
+}
+
+TEST_F(MyVecTest, AppendRangeMovesFromRvalue) {
+    Vector<std::string> src;
+    src.pushBack(std::string(50, 'q'));
+    src.pushBack(std::string(50, 'r'));
+    Vector<std::string> vec;
+    vec.appendRange(std::move(src));
+    EXPECT_EQ(vec.size(), 2);
+    EXPECT_EQ(vec[1], std::string(50, 'r'));
+    EXPECT_TRUE(src[0].empty());
+}
+
+TEST_F(MyVecTest, AppendRangeFromView) {
+    Vector<int> vec;
+    vec.appendRange(std::views::iota(0, 10) | std::views::filter([](int i) { return i % 2 == 0; }));
+    EXPECT_EQ(vec.size(), 5);
+    EXPECT_EQ(vec[4], 8);
+}
+
+TEST_F(MyVecTest, InsertRangeInPlace) {
+    Vector<int> vec{1, 2, 6};
+    vec.reserve(10);
+    int mid[] = {3, 4, 5};
+    auto it = vec.insert(vec.begin() + 2, std::begin(mid), std::end(mid));
+    EXPECT_EQ(it, vec.begin() + 2);
+    EXPECT_EQ(vec.size(), 6);
+    for (int i = 0; i < 6; ++i) {
+        EXPECT_EQ(vec[i], i + 1);
+    }
+}
+
+TEST_F(MyVecTest, InsertRangeWithGrowth) {
+    Vector<std::string> vec;
+    vec.pushBack("front");
+    vec.pushBack("back");
+    std::vector<std::string> mid(20, std::string(40, 'm'));
+    auto it = vec.insert(vec.begin() + 1, mid.begin(), mid.end());
+    EXPECT_EQ(*it, mid[0]);
+    EXPECT_EQ(vec.size(), 22);
+    EXPECT_EQ(vec[0], "front");
+    EXPECT_EQ(vec[21], "back");
+}
+
+TEST_F(MyVecTest, InsertRangeFromInputIterator) {
+    std::istringstream in{"7 8 9"};
+    Vector<int> vec{1, 2};
+    vec.insert(vec.begin() + 1, std::istream_iterator<int>{in}, std::istream_iterator<int>{});
+    EXPECT_EQ(vec.size(), 5);
+    EXPECT_EQ(vec[0], 1);
+    EXPECT_EQ(vec[1], 7);
+    EXPECT_EQ(vec[3], 9);
+    EXPECT_EQ(vec[4], 2);
+}
+
+#if defined(__cpp_lib_containers_ranges)
+TEST_F(MyVecTest, FromRangeConstructor) {
+    Vector<int> vec(std::from_range, std::views::iota(0, 5));
+    EXPECT_EQ(vec.size(), 5);
+    EXPECT_EQ(vec[4], 4);
+}
+#endif
+
+TEST_F(MyVecTest, ResizeForOverwrite) {
+    Vector<char> vec(2, 'a');
+    vec.resizeForOverwrite(6);
+    EXPECT_EQ(vec.size(), 6);
+    EXPECT_GE(vec.capacity(), 6);
+    EXPECT_EQ(vec[1], 'a');
+    std::memcpy(vec.data() + 2, "bcde", 4);
+    EXPECT_EQ(std::string_view(vec.data(), vec.size()), "aabcde");
+    vec.resizeForOverwrite(3);
+    EXPECT_EQ(vec.size(), 3);
+}
+
+TEST_F(MyVecTest, ResizeAndOverwrite) {
+    Vector<char> vec;
+    vec.resizeAndOverwrite(16, [](char* buf, std::size_t n) {
+        EXPECT_EQ(n, 16);
+        std::memcpy(buf, "hello", 5);
+        return std::size_t{5};
+    });
+    EXPECT_EQ(std::string_view(vec.data(), vec.size()), "hello");
+    EXPECT_THROW(vec.resizeAndOverwrite(4, [](char*, std::size_t n) { return n + 1; }), std::length_error);
+}
+
+TEST_F(MyVecTest, ResizeAndOverwriteNonTrivial) {
+    Vector<std::string> vec;
+    vec.pushBack("keep");
+    vec.resizeAndOverwrite(4, [](std::string* buf, std::size_t) {
+        buf[1] = "x";
+        return std::size_t{2};
+    });
+    EXPECT_EQ(vec.size(), 2);
+    EXPECT_EQ(vec[0], "keep");
+    EXPECT_EQ(vec[1], "x");
+}
+
+TEST_F(MyVecTest, GrowthPolicies) {
+    EXPECT_EQ(GrowDouble::nextCapacity(0, 1, 4), 4);
+    EXPECT_EQ(GrowDouble::nextCapacity(8, 9, 4), 16);
+    EXPECT_EQ(GrowOneAndHalf::nextCapacity(8, 9, 4), 12);
+    EXPECT_EQ(GrowOneAndHalf::nextCapacity(8, 100, 4), 100);
+    EXPECT_EQ(GrowSizeClass::roundToSizeClass(1), 16);
+    EXPECT_EQ(GrowSizeClass::roundToSizeClass(129), 160);
+    EXPECT_EQ(GrowSizeClass::roundToSizeClass(1025), 1280);
+    EXPECT_EQ(GrowSizeClass::roundToSizeClass(70000), 73728);
+    EXPECT_EQ(GrowSizeClass::nextCapacity(0, 1, 8), 4);
+    EXPECT_EQ(GrowSizeClass::nextCapacity(100, 101, 8), 160);
+}
+
+TEST_F(MyVecTest, OneAndHalfGrowthPolicy) {
+    Vector<int, std::allocator<int>, GrowOneAndHalf> vec;
+    for (int i = 0; i < 7; ++i) {
+        vec.pushBack(i);
+    }
+    EXPECT_EQ(vec.capacity(), 9);
+    EXPECT_EQ(vec[6], 6);
+}
+
+TEST_F(MyVecTest, StatsCountReallocations) {
+    Vector<std::uint64_t, std::allocator<std::uint64_t>, GrowDouble, VectorStats> vec;
+    for (std::uint64_t i = 0; i < 20; ++i) {
+        vec.pushBack(i);
+    }
+    EXPECT_EQ(vec.stats().reallocations, 3);
+    EXPECT_EQ(vec.stats().bytesCopied, (4 + 8 + 16) * sizeof(std::uint64_t));
+    EXPECT_EQ(vec.stats().peakCapacity, 32);
+    vec.shrinkToFit();
+    EXPECT_EQ(vec.stats().peakCapacity, 32);
+    EXPECT_EQ(vec.stats().reallocations, 4);
+}
+
+TEST_F(MyVecTest, DefaultStatsAddNoSize) {
+    EXPECT_EQ(sizeof(Vector<int>), sizeof(Vector<int, std::allocator<int>, GrowOneAndHalf>));
+    EXPECT_EQ(sizeof(Vector<int>) + sizeof(VectorStats),
+              sizeof(Vector<int, std::allocator<int>, GrowDouble, VectorStats>));
+}
+
+TEST_F(MyVecTest, FindCountContains) {
+    Vector<int> vec;
+    for (int i = 0; i < 100; ++i) {
+        vec.pushBack(i % 10);
+    }
+    EXPECT_EQ(vec.find(7), vec.begin() + 7);
+    EXPECT_EQ(vec.find(11), vec.end());
+    EXPECT_EQ(vec.count(3), 10);
+    EXPECT_TRUE(vec.contains(9));
+    EXPECT_FALSE(vec.contains(-1));
+}
+
+TEST_F(MyVecTest, EraseByValue) {
+    Vector<std::uint64_t> ints;
+    Vector<std::string> strs;
+    for (std::uint64_t i = 0; i < 100; ++i) {
+        ints.pushBack(i % 3);
+        strs.pushBack(std::to_string(i % 3));
+    }
+    ints.erase(1);
+    strs.erase("1");
+    EXPECT_EQ(ints.size(), 67);
+    EXPECT_EQ(strs.size(), 67);
+    EXPECT_FALSE(ints.contains(1));
+    EXPECT_EQ(strs.find("1"), strs.end());
+    EXPECT_EQ(ints[1], 2);
+    EXPECT_EQ(strs[1], "2");
+}